@@ -0,0 +1,189 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "autotune.h"
+
+//---------- HELPER FUNCTIONS ----------
+// Tunings used by new boards
+static vector<GoLTuning> loadedTunings;
+// Guards the loaded tunings, boards can be made from any thread
+static mutex tuningsMutex;
+
+// Name of the kernel in the tuning file
+static const char* kernelName(GoLKernel kernel){
+    return kernel == GoLKernel::LookupTable ? "LookupTable" : "Rows";
+}
+
+//---------- AUTOTUNING ----------
+GoLTuning autotuneGameOfLife(int rows, int cols){
+    // Candidates, every thread count is limited to what the machine has
+    int tileSizes[] = {16, 32, 64, 128};
+    GoLKernel kernels[] = {GoLKernel::Rows, GoLKernel::LookupTable};
+    int hardwareThreads = max(1, (int) thread::hardware_concurrency());
+    vector<int> threadCounts = {1};
+    for(int threads = 2; threads < hardwareThreads; threads *= 2){
+        threadCounts.push_back(threads);
+    }
+    if(hardwareThreads > 1){
+        threadCounts.push_back(hardwareThreads);
+    }
+
+    // Every candidate starts from the same board, restarted often enough that the timing covers the busy first steps of a random board rather than the ash it settles into
+    GameOfLife start = GameOfLife(rows, cols);
+    start.randomBoard(0.3);
+    int repeats = (int) max(1LL, GAME_OF_LIFE_TUNING_CELLS / ((long long) rows * cols * GAME_OF_LIFE_TUNING_STEPS));
+
+    GoLTuning best = {rows, cols, GAME_OF_LIFE_DEFAULT_TILE_SIZE, 1, GoLKernel::Rows, 0.0};
+    for(int tileSize : tileSizes){
+        for(int threads : threadCounts){
+            for(GoLKernel kernel : kernels){
+                GameOfLife game = GameOfLife(start);
+                game.setTileSize(tileSize);
+                game.setThreads(threads);
+                game.setKernel(kernel);
+
+                double seconds = 0.0;
+                for(int r = 0; r < repeats; r++){
+                    // Copy the board in without touching the settings
+                    start.getBoardSafe(game.getBoard());
+                    game.invalidateTiles();
+                    auto begin = chrono::steady_clock::now();
+                    for(int k = 0; k < GAME_OF_LIFE_TUNING_STEPS; k++){
+                        game.step();
+                    }
+                    auto end = chrono::steady_clock::now();
+                    seconds += chrono::duration<double>(end - begin).count();
+                }
+                double secondsPerStep = seconds / ((double) repeats * GAME_OF_LIFE_TUNING_STEPS);
+                if(best.secondsPerStep == 0.0 || secondsPerStep < best.secondsPerStep){
+                    best = {rows, cols, tileSize, threads, kernel, secondsPerStep};
+                }
+            }
+        }
+    }
+    return best;
+}
+
+bool autotuneAndSave(const string& filename, ostream& os){
+    vector<GoLTuning> tunings;
+    for(int s = 0; s < GAME_OF_LIFE_TUNING_NUM_SIZES; s++){
+        int size = GAME_OF_LIFE_TUNING_SIZES[s];
+        GoLTuning tuning = autotuneGameOfLife(size, size);
+        os << size << " x " << size << ": tile size " << tuning.tileSize << ", " << tuning.threads << " threads, " << kernelName(tuning.kernel) << " kernel, " << tuning.secondsPerStep << "s per step\n";
+        tunings.push_back(tuning);
+    }
+    return saveTunings(filename, tunings);
+}
+
+//---------- TUNING FILE ----------
+bool saveTunings(const string& filename, const vector<GoLTuning>& tunings){
+    ofstream file(filename);
+    if(!file){
+        return false;
+    }
+    file << "# rows cols tileSize threads kernel secondsPerStep\n";
+    for(const GoLTuning& tuning : tunings){
+        file << tuning.rows << " " << tuning.cols << " " << tuning.tileSize << " " << tuning.threads << " " << kernelName(tuning.kernel) << " " << tuning.secondsPerStep << "\n";
+    }
+    return (bool) file;
+}
+
+bool loadTunings(const string& filename){
+    vector<GoLTuning> tunings;
+    ifstream file(filename);
+    string line;
+    bool valid = (bool) file;
+    while(valid && getline(file, line)){
+        if(line.empty() || line[0] == '#'){
+            continue;
+        }
+
+        // Every field has to be there and make sense
+        stringstream sstream(line);
+        GoLTuning tuning;
+        string kernel;
+        valid = (bool) (sstream >> tuning.rows >> tuning.cols >> tuning.tileSize >> tuning.threads >> kernel >> tuning.secondsPerStep);
+        valid = valid && tuning.rows > 0 && tuning.cols > 0 && tuning.tileSize > 0 && tuning.threads > 0;
+        valid = valid && (kernel == "Rows" || kernel == "LookupTable");
+        tuning.kernel = kernel == "LookupTable" ? GoLKernel::LookupTable : GoLKernel::Rows;
+        tunings.push_back(tuning);
+    }
+
+    lock_guard<mutex> lock(tuningsMutex);
+    loadedTunings = valid ? tunings : vector<GoLTuning>();
+    return valid && !tunings.empty();
+}
+
+void clearTunings(){
+    lock_guard<mutex> lock(tuningsMutex);
+    loadedTunings.clear();
+}
+
+bool findTuning(int rows, int cols, GoLTuning& tuning){
+    lock_guard<mutex> lock(tuningsMutex);
+
+    // Closest number of cells on a log scale
+    double bestDistance = 0.0;
+    bool found = false;
+    for(const GoLTuning& candidate : loadedTunings){
+        double distance = fabs(log((double) rows * cols) - log((double) candidate.rows * candidate.cols));
+        if(!found || distance < bestDistance){
+            tuning = candidate;
+            bestDistance = distance;
+            found = true;
+        }
+    }
+    return found;
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_autotune(){
+    // Tune two small sizes and save them
+    string filename = "autotune-test.tuning";
+    vector<GoLTuning> tunings = {autotuneGameOfLife(40, 40), autotuneGameOfLife(200, 200)};
+    for(const GoLTuning& tuning : tunings){
+        cout << tuning.rows << " x " << tuning.cols << ": tile size " << tuning.tileSize << ", " << tuning.threads << " threads, " << kernelName(tuning.kernel) << " kernel, " << tuning.secondsPerStep << "s per step\n";
+    }
+    bool passed = saveTunings(filename, tunings) && loadTunings(filename);
+    remove(filename.c_str());
+
+    // New boards should pick up the tuning of the closest size
+    GoLTuning tuning;
+    passed = passed && findTuning(50, 30, tuning) && tuning.rows == 40;
+    passed = passed && findTuning(300, 150, tuning) && tuning.rows == 200;
+    GameOfLife tuned = GameOfLife(210, 190);
+    passed = passed && tuned.getTileSize() == tunings[1].tileSize && tuned.getThreads() == tunings[1].threads && tuned.getKernel() == tunings[1].kernel;
+    cout << "Tuning file: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // The tuning should not change the result
+    clearTunings();
+    GameOfLife plain = GameOfLife(210, 190);
+    plain.randomBoard(0.3);
+    plain.getBoardSafe(tuned.getBoard());
+    tuned.invalidateTiles();
+    passed = true;
+    for(int k = 0; k < 100 && passed; k++){
+        passed = plain.step() == tuned.step();
+    }
+    bool** plainBoard = plain.getBoard();
+    bool** board = tuned.getBoard();
+    for(int i = 0; i < 210 && passed; i++){
+        for(int j = 0; j < 190 && passed; j++){
+            passed = plainBoard[i][j] == board[i][j];
+        }
+    }
+    cout << "Tuned step: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // A missing file leaves the defaults
+    passed = !loadTunings(filename) && !findTuning(40, 40, tuning) && GameOfLife(40, 40).getTileSize() == GAME_OF_LIFE_DEFAULT_TILE_SIZE;
+    cout << "Missing tuning file: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Go back to the tuning of this machine
+    loadTunings(GAME_OF_LIFE_TUNING_FILE);
+}
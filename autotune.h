@@ -0,0 +1,68 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "gameoflife.h"
+
+using namespace std;
+
+/*
+Autotune
+
+No single tile size, thread count or kernel is the fastest GameOfLife::step() for every machine and board size. The autotuner times every combination of the candidates on random boards of a few sizes on this machine and saves the fastest one for each size to a tuning file (game-of-life -T).
+
+The tuning file is loaded once at startup. Every GameOfLife made afterwards, including the ones inside GameOfLifeGA, starts with the tuning of the closest board size that was tuned. The settings only change how fast a step is, never the result.
+
+The tuning file is plain text with one board size per line:
+    rows cols tileSize threads kernel secondsPerStep
+*/
+
+//---------- CONSTANTS ----------
+// Default tuning file, in the working directory
+const string GAME_OF_LIFE_TUNING_FILE = "game-of-life.tuning";
+// Sides of the square boards tuned by -T
+const int GAME_OF_LIFE_TUNING_SIZES[] = {32, 128, 512, 2048};
+const int GAME_OF_LIFE_TUNING_NUM_SIZES = 4;
+// Number of cells stepped for every candidate, so every board size takes about as long to tune
+const long long GAME_OF_LIFE_TUNING_CELLS = 1LL << 24;
+// Number of steps timed from the starting board before it is reset
+const int GAME_OF_LIFE_TUNING_STEPS = 32;
+
+// Fastest settings found for a board size
+struct GoLTuning {
+    // Size of the board that was tuned
+    int rows;
+    int cols;
+    // Settings
+    int tileSize;
+    int threads;
+    GoLKernel kernel;
+    // Time of a single step with the settings
+    double secondsPerStep;
+};
+
+//---------- AUTOTUNING ----------
+// Times every candidate setting on a random rows x cols board and returns the fastest
+GoLTuning autotuneGameOfLife(int rows, int cols);
+// Tunes every board size in GAME_OF_LIFE_TUNING_SIZES, reporting progress to os, and saves the results to the file
+// Returns false if the file could not be written
+bool autotuneAndSave(const string& filename, ostream& os);
+
+//---------- TUNING FILE ----------
+// Writes the tunings to the file, returns false if it could not be written
+bool saveTunings(const string& filename, const vector<GoLTuning>& tunings);
+// Replaces the tunings used by new GameOfLife boards with the ones in the file
+// Returns false and leaves no tunings if the file is missing or not a tuning file
+bool loadTunings(const string& filename);
+// Forgets the loaded tunings so new boards use the defaults
+void clearTunings();
+// Looks up the tuning of the tuned board size closest to rows x cols, returns false if there are no tunings
+bool findTuning(int rows, int cols, GoLTuning& tuning);
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_autotune();
+
+#endif
@@ -0,0 +1,391 @@
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "batchgameoflife.h"
+#include "bitgameoflife.h"
+
+//---------- HELPER FUNCTIONS ----------
+// Number of bits needed to hold the value
+static inline int bitWidth(long long value){
+    int bits = 1;
+    while((value >> bits) != 0){
+        bits++;
+    }
+    return bits;
+}
+
+// Adds 1 to the bit-sliced counter of every lane set in the word
+static inline void addSliced(uint64_t* counter, uint64_t word){
+    for(int b = 0; word; b++){
+        uint64_t carry = counter[b] & word;
+        counter[b] ^= word;
+        word = carry;
+    }
+}
+
+// Adds the bit-sliced number of every lane to the bit-sliced counter of that lane
+static inline void addSlicedNumber(uint64_t* counter, const uint64_t* number, int numberBits){
+    uint64_t carry = 0;
+    int b = 0;
+    for(; b < numberBits; b++){
+        uint64_t sum = counter[b] ^ number[b];
+        uint64_t nextCarry = (counter[b] & number[b]) | (carry & sum);
+        counter[b] = sum ^ carry;
+        carry = nextCarry;
+    }
+    addSliced(counter + b, carry);
+}
+
+// Adds the count of every lane in a bit-sliced counter, shifted left by shift, to values
+// Only the set bits are visited so counters that are mostly 0 are cheap to read
+static inline void addLaneValues(const uint64_t* counter, int bits, int shift, long long* values){
+    for(int b = 0; b < bits; b++){
+        for(uint64_t lanes = counter[b]; lanes; lanes &= lanes - 1){
+            values[__builtin_ctzll(lanes)] += 1LL << (b + shift);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------
+//---------- BatchGameOfLife ----------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+BatchGameOfLife::BatchGameOfLife() : BatchGameOfLife(GAME_OF_LIFE_DEFAULT_ROWS, GAME_OF_LIFE_DEFAULT_COLS) {}
+
+BatchGameOfLife::BatchGameOfLife(int rows, int cols) : rows(rows), cols(cols), cells(nullptr), nextCells(nullptr), counterBits(0), counters(nullptr), rowAny(nullptr), colAny(nullptr) {
+    allocBoard();
+    clear();
+}
+
+BatchGameOfLife::BatchGameOfLife(const BatchGameOfLife & other) : rows(other.rows), cols(other.cols), cells(nullptr), nextCells(nullptr), counterBits(0), counters(nullptr), rowAny(nullptr), colAny(nullptr) {
+    // Deep copy the boards
+    allocBoard();
+    memcpy(cells, other.cells, rows * cols * sizeof(uint64_t));
+}
+
+BatchGameOfLife& BatchGameOfLife::operator=(const BatchGameOfLife & other){
+    if(this != &other){
+        // Delete the old boards
+        deleteBoard();
+
+        // Deep copy the boards
+        rows = other.rows;
+        cols = other.cols;
+        allocBoard();
+        memcpy(cells, other.cells, rows * cols * sizeof(uint64_t));
+    }
+    return *this;
+}
+
+BatchGameOfLife::~BatchGameOfLife(){
+    deleteBoard();
+}
+
+//---------- UTILITIES ----------
+void BatchGameOfLife::clear(){
+    memset(cells, 0, rows * cols * sizeof(uint64_t));
+}
+
+void BatchGameOfLife::addOrganism(int lane, int orgRows, int orgCols, bool* organism){
+    // Clear the lane
+    uint64_t bit = (uint64_t) 1 << lane;
+    for(int i = 0; i < rows * cols; i++){
+        cells[i] &= ~bit;
+    }
+
+    // Copy the organism into roughly the center of the board
+    int rowPad = (rows - orgRows) / 2;
+    int colPad = (cols - orgCols) / 2;
+    int index = 0;
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            if(organism[index]){
+                cells[(rowPad + i) * cols + colPad + j] |= bit;
+            }
+            index++;
+        }
+    }
+}
+
+void BatchGameOfLife::addOrganism(int lane, int orgRows, int orgCols, char* organism){
+    // Clear the lane
+    uint64_t bit = (uint64_t) 1 << lane;
+    for(int i = 0; i < rows * cols; i++){
+        cells[i] &= ~bit;
+    }
+
+    // Copy the organism into roughly the center of the board
+    int rowPad = (rows - orgRows) / 2;
+    int colPad = (cols - orgCols) / 2;
+    int index = 0;
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            if((bool) organism[index]){
+                cells[(rowPad + i) * cols + colPad + j] |= bit;
+            }
+            index++;
+        }
+    }
+}
+
+uint64_t BatchGameOfLife::step(long long* changes){
+    // Lanes that changed
+    uint64_t changed = 0;
+    if(changes){
+        memset(counters, 0, counterBits * sizeof(uint64_t));
+    }
+
+    for(int i = 0; i < rows; i++){
+        // Rows surrounding the current row, wrapping around the top and bottom
+        const uint64_t* up = cells + ((i + rows - 1) % rows) * cols;
+        const uint64_t* mid = cells + i * cols;
+        const uint64_t* down = cells + ((i + 1) % rows) * cols;
+        uint64_t* next = nextCells + i * cols;
+        for(int j = 0; j < cols; j++){
+            // Columns surrounding the current column, wrapping around the sides
+            int west = j == 0 ? cols - 1 : j - 1;
+            int east = j == cols - 1 ? 0 : j + 1;
+
+            // Every bit is a cell of a different board so the bitwise kernel steps them all
+            next[j] = lifeWord(up[west], up[j], up[east], mid[west], mid[j], mid[east], down[west], down[j], down[east]);
+            uint64_t diff = next[j] ^ mid[j];
+            changed |= diff;
+            if(changes && diff){
+                addSliced(counters, diff);
+            }
+        }
+    }
+
+    // Pointer shuffle
+    uint64_t* temp = cells;
+    cells = nextCells;
+    nextCells = temp;
+
+    // Read out the counts of every lane
+    if(changes){
+        for(int lane = 0; lane < BATCH_GAME_OF_LIFE_LANES; lane++){
+            changes[lane] = 0;
+        }
+        addLaneValues(counters, counterBits, 0, changes);
+    }
+    return changed;
+}
+
+void BatchGameOfLife::getStatistics(GoLStatistics* stats){
+    // Every cell is counted into the counter of its row and the counter of its column
+    // The index sums are then built from one counter per bit of the index, adding in the rows and columns whose index has that bit set
+    int rowBits = bitWidth(rows - 1);
+    int colBits = bitWidth(cols - 1);
+    int rowCountBits = bitWidth(cols);
+    int colCountBits = bitWidth(rows);
+    uint64_t* population = counters;
+    uint64_t* rowPlanes = population + counterBits;
+    uint64_t* colPlanes = rowPlanes + rowBits * counterBits;
+    uint64_t* rowCount = colPlanes + colBits * counterBits;
+    uint64_t* colCounts = rowCount + rowCountBits;
+    memset(counters, 0, ((1 + rowBits + colBits) * counterBits + rowCountBits + cols * colCountBits) * sizeof(uint64_t));
+    memset(colAny, 0, cols * sizeof(uint64_t));
+
+    // Count every cell that is on into the counters
+    for(int i = 0; i < rows; i++){
+        const uint64_t* row = cells + i * cols;
+        uint64_t any = 0;
+        memset(rowCount, 0, rowCountBits * sizeof(uint64_t));
+        for(int j = 0; j < cols; j++){
+            uint64_t word = row[j];
+            if(!word){
+                continue;
+            }
+            addSliced(rowCount, word);
+            addSliced(colCounts + j * colCountBits, word);
+            any |= word;
+            colAny[j] |= word;
+        }
+        rowAny[i] = any;
+        if(!any){
+            continue;
+        }
+        addSlicedNumber(population, rowCount, rowCountBits);
+        for(int b = 0; b < rowBits; b++){
+            if((i >> b) & 1){
+                addSlicedNumber(rowPlanes + b * counterBits, rowCount, rowCountBits);
+            }
+        }
+    }
+    for(int j = 0; j < cols; j++){
+        if(!colAny[j]){
+            continue;
+        }
+        for(int b = 0; b < colBits; b++){
+            if((j >> b) & 1){
+                addSlicedNumber(colPlanes + b * counterBits, colCounts + j * colCountBits, colCountBits);
+            }
+        }
+    }
+
+    // Read out the counts of every lane
+    long long populations[BATCH_GAME_OF_LIFE_LANES] = {0};
+    long long rowSums[BATCH_GAME_OF_LIFE_LANES] = {0};
+    long long colSums[BATCH_GAME_OF_LIFE_LANES] = {0};
+    addLaneValues(population, counterBits, 0, populations);
+    for(int b = 0; b < rowBits; b++){
+        addLaneValues(rowPlanes + b * counterBits, counterBits, b, rowSums);
+    }
+    for(int b = 0; b < colBits; b++){
+        addLaneValues(colPlanes + b * counterBits, counterBits, b, colSums);
+    }
+    for(int lane = 0; lane < BATCH_GAME_OF_LIFE_LANES; lane++){
+        stats[lane] = GoLStatistics();
+        stats[lane].population = populations[lane];
+        stats[lane].rowSum = rowSums[lane];
+        stats[lane].colSum = colSums[lane];
+    }
+
+    // The first and last rows and columns to have a lane on are its bounding box
+    uint64_t seen = 0;
+    for(int i = 0; i < rows; i++){
+        for(uint64_t lanes = rowAny[i] & ~seen; lanes; lanes &= lanes - 1){
+            stats[__builtin_ctzll(lanes)].minRow = i;
+        }
+        seen |= rowAny[i];
+    }
+    seen = 0;
+    for(int i = rows - 1; i >= 0; i--){
+        for(uint64_t lanes = rowAny[i] & ~seen; lanes; lanes &= lanes - 1){
+            stats[__builtin_ctzll(lanes)].maxRow = i;
+        }
+        seen |= rowAny[i];
+    }
+    seen = 0;
+    for(int j = 0; j < cols; j++){
+        for(uint64_t lanes = colAny[j] & ~seen; lanes; lanes &= lanes - 1){
+            stats[__builtin_ctzll(lanes)].minCol = j;
+        }
+        seen |= colAny[j];
+    }
+    seen = 0;
+    for(int j = cols - 1; j >= 0; j--){
+        for(uint64_t lanes = colAny[j] & ~seen; lanes; lanes &= lanes - 1){
+            stats[__builtin_ctzll(lanes)].maxCol = j;
+        }
+        seen |= colAny[j];
+    }
+}
+
+void BatchGameOfLife::setBoard(int lane, bool** data){
+    uint64_t bit = (uint64_t) 1 << lane;
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            if(data[i][j]){
+                cells[i * cols + j] |= bit;
+            } else {
+                cells[i * cols + j] &= ~bit;
+            }
+        }
+    }
+}
+
+void BatchGameOfLife::getBoardSafe(int lane, bool** data) const{
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            data[i][j] = getCell(lane, i, j);
+        }
+    }
+}
+
+bool BatchGameOfLife::getCell(int lane, int row, int col) const{
+    return (cells[row * cols + col] >> lane) & 1;
+}
+
+//---------- PRIVATE UTILITIES ----------
+void BatchGameOfLife::allocBoard(){
+    cells = new uint64_t[rows * cols];
+    nextCells = new uint64_t[rows * cols];
+    counterBits = bitWidth((long long) rows * cols);
+    counters = new uint64_t[(1 + bitWidth(rows - 1) + bitWidth(cols - 1)) * counterBits + bitWidth(cols) + cols * bitWidth(rows)];
+    rowAny = new uint64_t[rows];
+    colAny = new uint64_t[cols];
+}
+
+void BatchGameOfLife::deleteBoard(){
+    // Check for nullptr and clean up the memory
+    if(cells){
+        delete[](cells);
+        delete[](nextCells);
+        delete[](counters);
+        delete[](rowAny);
+        delete[](colAny);
+        cells = nullptr;
+        nextCells = nullptr;
+        counters = nullptr;
+        rowAny = nullptr;
+        colAny = nullptr;
+    }
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_BatchGameOfLife(){
+    // Step a different random board in every lane next to the GameOfLife class
+    int rows = 37;
+    int cols = 45;
+    GameOfLife* games = new GameOfLife[BATCH_GAME_OF_LIFE_LANES];
+    BatchGameOfLife batch = BatchGameOfLife(rows, cols);
+    for(int lane = 0; lane < BATCH_GAME_OF_LIFE_LANES; lane++){
+        // Leave a few lanes empty
+        games[lane] = GameOfLife(rows, cols);
+        if(lane % 16 != 5){
+            games[lane].randomBoard(0.05 + 0.01 * lane);
+        }
+        batch.setBoard(lane, games[lane].getBoard());
+    }
+
+    // Compare the boards, the changes and the statistics
+    bool passed = true;
+    long long changes[BATCH_GAME_OF_LIFE_LANES];
+    GoLStatistics stats[BATCH_GAME_OF_LIFE_LANES];
+    for(int k = 0; k < 200 && passed; k++){
+        batch.step(changes);
+        batch.getStatistics(stats);
+        for(int lane = 0; lane < BATCH_GAME_OF_LIFE_LANES && passed; lane++){
+            passed = changes[lane] == games[lane].step();
+            bool** board = games[lane].getBoard();
+            for(int i = 0; i < rows && passed; i++){
+                for(int j = 0; j < cols && passed; j++){
+                    passed = board[i][j] == batch.getCell(lane, i, j);
+                }
+            }
+            GoLStatistics expected = games[lane].getStatistics();
+            passed = passed && stats[lane].population == expected.population && stats[lane].rowSum == expected.rowSum && stats[lane].colSum == expected.colSum;
+            passed = passed && stats[lane].minRow == expected.minRow && stats[lane].maxRow == expected.maxRow && stats[lane].minCol == expected.minCol && stats[lane].maxCol == expected.maxCol;
+        }
+    }
+    delete[](games);
+    cout << "BatchGameOfLife: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // The batched fitness evaluation should give the same fitness as evaluating the members one at a time
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::CenterOfMassMotion};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "CenterOfMassMotion"};
+    for(int f = 0; f < 3; f++){
+        GameOfLifeGA ga = GameOfLifeGA(100, 13 * 13, 2, actions, 1, 0.1, 1, 27, 27, functions[f], 500, 13, 13);
+        GameOfLifeGA singleGA = GameOfLifeGA(ga);
+        singleGA.setBatching(false);
+
+        // Time both
+        auto start = chrono::steady_clock::now();
+        ga.evalFitness();
+        auto middle = chrono::steady_clock::now();
+        singleGA.evalFitness();
+        auto end = chrono::steady_clock::now();
+        passed = true;
+        for(int member = 0; member < 100 && passed; member++){
+            double batched = ga.getFitness(member);
+            double single = singleGA.getFitness(member);
+            passed = fabs(batched - single) <= 1e-9 * max(1.0, fabs(single));
+        }
+        cout << "Batched " << names[f] << ": " << (passed ? "PASSED" : "FAILED");
+        cout << " (batched " << chrono::duration<double>(middle - start).count() << "s, one at a time " << chrono::duration<double>(end - middle).count() << "s)\n";
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef BATCH_GAME_OF_LIFE_H
+#define BATCH_GAME_OF_LIFE_H
+
+#include <cstdint>
+
+#include "gameoflife.h"
+
+using namespace std;
+
+//---------- CONSTANTS ----------
+// Number of boards simulated at once, one per bit of a word
+const int BATCH_GAME_OF_LIFE_LANES = 64;
+
+// Many independent Game of Life boards of the same size stepped together
+// Every cell is a single word holding that cell of every board, bit k belongs to the board in lane k, so one pass of the bitwise kernel steps every board
+// Uses the same toroidal (i.e. wrap around) domain as the GameOfLife class and produces identical results for every lane
+// Note: only runs Conway's rule
+class BatchGameOfLife{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        BatchGameOfLife();
+        BatchGameOfLife(int rows, int cols);
+        BatchGameOfLife(const BatchGameOfLife & other);
+        BatchGameOfLife& operator=(const BatchGameOfLife & other);
+        ~BatchGameOfLife();
+
+        //---------- UTILITIES ----------
+        // Turns every cell of every board off
+        void clear();
+        // Adds the organism to the board of the lane, in the same place GameOfLife::addOrganism puts it, clearing only that lane first
+        void addOrganism(int lane, int orgRows, int orgCols, bool* organism);
+        void addOrganism(int lane, int orgRows, int orgCols, char* organism);
+        // Performs a single step of every board, returning a mask of the lanes that changed
+        // If changes is not nullptr it is filled with the number of tiles changed in every lane
+        uint64_t step(long long* changes = nullptr);
+        // Fills stats with the population, index sums and bounding box of the board in every lane
+        void getStatistics(GoLStatistics* stats);
+        // Overwrites the board of the lane with the data - allows for moving a board over from the GameOfLife class
+        void setBoard(int lane, bool** data);
+        // Creates a copy of the board of the lane
+        void getBoardSafe(int lane, bool** data) const;
+        // Returns the state of a single tile of the board of the lane
+        bool getCell(int lane, int row, int col) const;
+    private:
+        // The number of rows in every board
+        int rows;
+        // The number of columns in every board
+        int cols;
+        // The boards themselves, rows * cols contiguous cells
+        uint64_t* cells;
+        // Scratch boards the next step is written into
+        uint64_t* nextCells;
+        // Number of bits needed to count every cell of a board
+        int counterBits;
+        // Bit-sliced counters, bit b of the count of lane k is bit k of counters[b]
+        uint64_t* counters;
+        // Lanes with a cell on in every row and column
+        uint64_t* rowAny;
+        uint64_t* colAny;
+
+        //---------- PRIVATE UTILITIES ----------
+        // Allocates the memory for the boards and counters
+        void allocBoard();
+        // Deletes the board data
+        void deleteBoard();
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_BatchGameOfLife();
+
+#endif
@@ -0,0 +1,271 @@
+#include <iostream>
+
+#include "rng.h"
+#include "bitgameoflife.h"
+#include "gameoflife.h"
+
+//---------- HELPER FUNCTIONS ----------
+// Returns the word where every cell holds the value of its left neighbor, wrapping the first column around to the last one
+static inline uint64_t westWord(const uint64_t* row, int w, int words, int cols){
+    uint64_t carry = w > 0 ? row[w - 1] >> 63 : (row[words - 1] >> ((cols - 1) % BIT_GAME_OF_LIFE_WORD_BITS)) & 1;
+    return (row[w] << 1) | carry;
+}
+
+// Returns the word where every cell holds the value of its right neighbor, wrapping the last column around to the first one
+static inline uint64_t eastWord(const uint64_t* row, int w, int words, int cols){
+    uint64_t shifted = row[w] >> 1;
+    if(w < words - 1){
+        shifted |= row[w + 1] << 63;
+    } else {
+        // Bits past the last column are 0 so the wrapped cell can be placed directly
+        shifted |= (row[0] & 1) << ((cols - 1) % BIT_GAME_OF_LIFE_WORD_BITS);
+    }
+    return shifted;
+}
+
+//-------------------------------------------------------------------------------------
+//---------- BitGameOfLife ------------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+BitGameOfLife::BitGameOfLife() : BitGameOfLife(GAME_OF_LIFE_DEFAULT_ROWS, GAME_OF_LIFE_DEFAULT_COLS) {}
+
+BitGameOfLife::BitGameOfLife(int rows, int cols) : rows(rows), cols(cols), words(0), tailMask(0), board(nullptr), nextBoard(nullptr) {
+    rng::seedRNG();
+    allocBoard();
+    resetBoard();
+}
+
+BitGameOfLife::BitGameOfLife(const BitGameOfLife & other) : rows(other.rows), cols(other.cols), words(0), tailMask(0), board(nullptr), nextBoard(nullptr) {
+    // Deep copy the board
+    allocBoard();
+    for(int i = 0; i < rows * words; i++){
+        board[i] = other.board[i];
+    }
+}
+
+BitGameOfLife& BitGameOfLife::operator=(const BitGameOfLife & other){
+    if(this != &other){
+        // Delete the old board
+        deleteBoard();
+
+        // Deep copy the board
+        rows = other.rows;
+        cols = other.cols;
+        allocBoard();
+        for(int i = 0; i < rows * words; i++){
+            board[i] = other.board[i];
+        }
+    }
+    return *this;
+}
+
+BitGameOfLife::~BitGameOfLife(){
+    deleteBoard();
+}
+
+//---------- UTILITIES ----------
+void BitGameOfLife::addOrganism(int orgRows, int orgCols, bool* organism){
+    // Reset the board
+    resetBoard();
+
+    // Copy the organism into roughly the center of the board
+    int rowPad = (rows - orgRows) / 2;
+    int colPad = (cols - orgCols) / 2;
+    int index = 0;
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            setCell(rowPad + i, colPad + j, organism[index]);
+            index++;
+        }
+    }
+}
+
+void BitGameOfLife::addOrganism(int orgRows, int orgCols, char* organism){
+    // Reset the board
+    resetBoard();
+
+    // Copy the organism into roughly the center of the board
+    int rowPad = (rows - orgRows) / 2;
+    int colPad = (cols - orgCols) / 2;
+    int index = 0;
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            setCell(rowPad + i, colPad + j, (bool) organism[index]);
+            index++;
+        }
+    }
+}
+
+void BitGameOfLife::randomBoard(double chance){
+    // Roll for determining if a square is on
+    double roll;
+
+    // Fill out the board
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            roll = rng::genRandDouble(0., 1.0);
+            if(roll < chance){
+                setCell(i, j, true);
+            }
+        }
+    }
+}
+
+int BitGameOfLife::step(){
+    // Count of the changed tiles
+    int count = 0;
+    // Rows surrounding the current row
+    const uint64_t* up;
+    const uint64_t* mid;
+    const uint64_t* down;
+    // Output row
+    uint64_t* next;
+    // Resulting word
+    uint64_t result;
+
+    // Apply rules of Conway's Game of Life with wrapping, a whole word at a time
+    for(int i = 0; i < rows; i++){
+        up = board + ((i + rows - 1) % rows) * words;
+        mid = board + i * words;
+        down = board + ((i + 1) % rows) * words;
+        next = nextBoard + i * words;
+
+        for(int w = 0; w < words; w++){
+            result = lifeWord(
+                westWord(up, w, words, cols), up[w], eastWord(up, w, words, cols),
+                westWord(mid, w, words, cols), mid[w], eastWord(mid, w, words, cols),
+                westWord(down, w, words, cols), down[w], eastWord(down, w, words, cols)
+            );
+            if(w == words - 1){
+                result &= tailMask;
+            }
+            next[w] = result;
+
+            // Count the number of changes
+            count += __builtin_popcountll(result ^ mid[w]);
+        }
+    }
+
+    // Pointer shuffle
+    uint64_t* temp = board;
+    board = nextBoard;
+    nextBoard = temp;
+
+    return count;
+}
+
+void BitGameOfLife::getBoardSafe(bool** data){
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            data[i][j] = getCell(i, j);
+        }
+    }
+}
+
+void BitGameOfLife::setBoard(bool** data){
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            setCell(i, j, data[i][j]);
+        }
+    }
+}
+
+bool BitGameOfLife::getCell(int row, int col) const{
+    return (board[row * words + col / BIT_GAME_OF_LIFE_WORD_BITS] >> (col % BIT_GAME_OF_LIFE_WORD_BITS)) & 1;
+}
+
+int BitGameOfLife::getPopulation() const{
+    int count = 0;
+    for(int i = 0; i < rows * words; i++){
+        count += __builtin_popcountll(board[i]);
+    }
+    return count;
+}
+
+//---------- DEBUGGING UTILITIES ----------
+ostream& operator<<(ostream& os, const BitGameOfLife& obj){
+    for(int i = 0; i < obj.rows; i++){
+        for(int j = 0; j < obj.cols; j++){
+            if(obj.getCell(i, j)){
+                os << "1";
+            } else {
+                os << "0";
+            }
+        }
+        os << "\n";
+    }
+    return os;
+}
+
+//---------- PRIVATE UTILITIES ----------
+void BitGameOfLife::allocBoard(){
+    // Round the columns up to a whole number of words
+    words = (cols + BIT_GAME_OF_LIFE_WORD_BITS - 1) / BIT_GAME_OF_LIFE_WORD_BITS;
+    int tailBits = cols - (words - 1) * BIT_GAME_OF_LIFE_WORD_BITS;
+    tailMask = tailBits == BIT_GAME_OF_LIFE_WORD_BITS ? ~((uint64_t) 0) : (((uint64_t) 1) << tailBits) - 1;
+
+    board = new uint64_t[rows * words];
+    nextBoard = new uint64_t[rows * words];
+}
+
+void BitGameOfLife::deleteBoard(){
+    // Check for nullptr and clean up the memory
+    if(board){
+        delete[](board);
+        board = nullptr;
+    }
+    if(nextBoard){
+        delete[](nextBoard);
+        nextBoard = nullptr;
+    }
+}
+
+void BitGameOfLife::resetBoard(){
+    for(int i = 0; i < rows * words; i++){
+        board[i] = 0;
+    }
+}
+
+void BitGameOfLife::setCell(int row, int col, bool val){
+    uint64_t bit = ((uint64_t) 1) << (col % BIT_GAME_OF_LIFE_WORD_BITS);
+    uint64_t& word = board[row * words + col / BIT_GAME_OF_LIFE_WORD_BITS];
+    if(val){
+        word |= bit;
+    } else {
+        word &= ~bit;
+    }
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_BitGameOfLife(){
+    // Boards which do and do not fill out the last word of a row
+    int sizes[][2] = {{17, 17}, {64, 64}, {100, 100}, {40, 70}, {70, 130}};
+    int numSteps = 50;
+
+    for(auto& size : sizes){
+        int rows = size[0];
+        int cols = size[1];
+
+        // Start both versions from the same random board
+        GameOfLife game = GameOfLife(rows, cols);
+        game.randomBoard(0.3);
+        BitGameOfLife bitGame = BitGameOfLife(rows, cols);
+        bitGame.setBoard(game.getBoard());
+
+        // Step both forward and compare the changes and the boards
+        bool passed = true;
+        for(int k = 0; k < numSteps && passed; k++){
+            int changes = game.step();
+            int bitChanges = bitGame.step();
+            passed = changes == bitChanges;
+
+            bool** board = game.getBoard();
+            for(int i = 0; i < rows && passed; i++){
+                for(int j = 0; j < cols && passed; j++){
+                    passed = board[i][j] == bitGame.getCell(i, j);
+                }
+            }
+        }
+        cout << "BitGameOfLife " << rows << "x" << cols << ": " << (passed ? "PASSED" : "FAILED") << "\n";
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef BIT_GAME_OF_LIFE_H
+#define BIT_GAME_OF_LIFE_H
+
+#include <cstdint>
+#include <ostream>
+
+using namespace std;
+
+//---------- CONSTANTS ----------
+// Number of cells packed into a single word of the board
+const int BIT_GAME_OF_LIFE_WORD_BITS = 64;
+
+//---------- BITWISE KERNEL ----------
+// Applies the rules of Conway's Game of Life to 64 cells at once
+// Each argument holds one of the 9 cells of the neighborhood for every bit position, the bits never interact with one another
+// The neighbor counts are built with bit-parallel half and full adders, so the count of every cell lives in three bit planes
+inline uint64_t lifeWord(uint64_t nw, uint64_t n, uint64_t ne, uint64_t w, uint64_t c, uint64_t e, uint64_t sw, uint64_t s, uint64_t se){
+    // Sum of the row above (2 bits)
+    uint64_t up0 = nw ^ n ^ ne;
+    uint64_t up1 = (nw & n) | (ne & (nw ^ n));
+    // Sum of the row below (2 bits)
+    uint64_t down0 = sw ^ s ^ se;
+    uint64_t down1 = (sw & s) | (se & (sw ^ s));
+    // Sum of the left and right neighbors (2 bits)
+    uint64_t mid0 = w ^ e;
+    uint64_t mid1 = w & e;
+
+    // Add the rows above and below (3 bits)
+    uint64_t sum0 = up0 ^ down0;
+    uint64_t carry0 = up0 & down0;
+    uint64_t sum1 = up1 ^ down1 ^ carry0;
+    uint64_t sum2 = (up1 & down1) | (carry0 & (up1 ^ down1));
+
+    // Add the left and right neighbors
+    uint64_t count0 = sum0 ^ mid0;
+    uint64_t carry1 = sum0 & mid0;
+    uint64_t count1 = sum1 ^ mid1 ^ carry1;
+    uint64_t carry2 = (sum1 & mid1) | (carry1 & (sum1 ^ mid1));
+    uint64_t count2 = sum2 ^ carry2;
+
+    // A count of 3 always lives and a count of 2 keeps a live cell alive
+    // Note: a count of 8 wraps to 0 in the three low bit planes which is still dead
+    return count1 & ~count2 & (count0 | c);
+}
+
+// Game of Life board with 64 cells packed into every word of a row
+// Uses the same toroidal (i.e. wrap around) domain as the GameOfLife class and produces identical results
+// The bits of the last word in a row past the final column are always kept at 0
+class BitGameOfLife{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        BitGameOfLife();
+        BitGameOfLife(int rows, int cols);
+        BitGameOfLife(const BitGameOfLife & other);
+        BitGameOfLife& operator=(const BitGameOfLife & other);
+        ~BitGameOfLife();
+
+        //---------- UTILITIES ----------
+        // Adds the organism to the board. Allows for both bool arrays and char arrays which match the genetic algorithm code
+        void addOrganism(int orgRows, int orgCols, bool* organism);
+        void addOrganism(int orgRows, int orgCols, char* organism);
+        // Generates a random board with chance being the chance (percent as decimal) that a board state starts occupied (true)
+        void randomBoard(double chance);
+        // Performs a single step of the game of life counting the net number of tiles changed
+        int step();
+        // Creates a copy of the board overwriting the data - provides write protection
+        void getBoardSafe(bool** data);
+        // Overwrites the board with the data - allows for moving a board over from the GameOfLife class
+        void setBoard(bool** data);
+        // Returns the state of a single tile
+        bool getCell(int row, int col) const;
+        // Counts the number of tiles that are on
+        int getPopulation() const;
+
+        //---------- DEBUGGING UTILITIES ----------
+        // Prints out as 0s and 1s to an ostream
+        friend ostream& operator<<(ostream& os, const BitGameOfLife& obj);
+    private:
+        // The number of rows in the game of life board
+        int rows;
+        // The number of columns in the game of life board
+        int cols;
+        // The number of words used to store a single row
+        int words;
+        // Mask of the valid bits in the last word of each row
+        uint64_t tailMask;
+        // The board itself, rows * words contiguous words
+        uint64_t* board;
+        // Scratch board the next step is written into
+        uint64_t* nextBoard;
+
+        //---------- PRIVATE UTILITIES ----------
+        // Allocates the memory for the boards
+        void allocBoard();
+        // Deletes the board data
+        void deleteBoard();
+        // Sets all the data in the board to 0
+        void resetBoard();
+        // Sets a single tile of the board
+        void setCell(int row, int col, bool val);
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_BitGameOfLife();
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef BIT_UTILS_H
+#define BIT_UTILS_H
+
+#include <cstdint>
+
+/*
+Bit Utilities
+
+Small helpers on 64 bit words shared by the bit packed simulations and the hashes of boards and genomes.
+*/
+
+//---------- CONSTANTS ----------
+// Masks of the bits whose position has bit b set, popcount(word & POSITION_BITS[b]) << b summed over b is the sum of the positions of the set bits
+inline constexpr uint64_t POSITION_BITS[6] = {0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL, 0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+
+//---------- FUNCTIONS ----------
+// Finalizer of SplitMix64, a bijection that scrambles every bit into every other bit
+inline uint64_t mixHash(uint64_t x){
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+#endif
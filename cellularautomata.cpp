@@ -4,6 +4,9 @@
 #include <sstream>
 
 #include "cellularautomata.h"
+#include "bitutils.h"
+#include "fitnesscache.h"
+#include "kernels.h"
 #include "rng.h"
 #include "sdl-basics.h"
 
@@ -79,10 +82,11 @@ void CellularAutomata1D::step(bool*& curr, int domainSize){
     next[0] = rules[ruleVal] == CA_TRUE;
     
     // Internals
-    for(int i = 1; i < domainSize - 1; i++){
-        ruleVal = curr[i - 1] * 4 + curr[i] * 2 + curr[i + 1];
-        next[i] = rules[ruleVal] == CA_TRUE;
+    bool table[8];
+    for(int i = 0; i < 8; i++){
+        table[i] = rules[i] == CA_TRUE;
     }
+    kernels::ca1DRow(curr + 1, next + 1, domainSize - 2, table);
 
     // Right side
     ruleVal = curr[domainSize - 2] * 4 + curr[domainSize - 1] * 2 + curr[0];
@@ -171,11 +175,11 @@ void CellularAutomata1D::snapShot(bool* start, int domainSize, int numSteps, int
 //---------- MajoritySolverGA ---------------------------------------------------------
 //-------------------------------------------------------------------------------------
 //---------- CONSTRUCTORS & DESTRUCTOR ----------
-MajoritySolverGA::MajoritySolverGA() : GeneticAlgorithm(), currAutomata(nullptr), numFitnessTests(-1), domainSize(-1), maxSteps(-1) {}
+MajoritySolverGA::MajoritySolverGA() : GeneticAlgorithm(), currAutomata(nullptr), numFitnessTests(-1), domainSize(-1), maxSteps(-1), fitnessCache(nullptr) {}
 
-MajoritySolverGA::MajoritySolverGA(int sizePopulation, int crossovers, double mutationRate, int numFitnessTests, int domainSize, int maxSteps) : GeneticAlgorithm(sizePopulation, 8, 2, CA_ACTIONS, crossovers, mutationRate), currAutomata(nullptr), numFitnessTests(numFitnessTests), domainSize(domainSize), maxSteps(maxSteps) {}
+MajoritySolverGA::MajoritySolverGA(int sizePopulation, int crossovers, double mutationRate, int numFitnessTests, int domainSize, int maxSteps) : GeneticAlgorithm(sizePopulation, 8, 2, CA_ACTIONS, crossovers, mutationRate), currAutomata(nullptr), numFitnessTests(numFitnessTests), domainSize(domainSize), maxSteps(maxSteps), fitnessCache(nullptr) {}
 
-MajoritySolverGA::MajoritySolverGA(const MajoritySolverGA & other) : GeneticAlgorithm(other), currAutomata(nullptr), numFitnessTests(other.numFitnessTests), domainSize(other.domainSize), maxSteps(other.maxSteps) {}
+MajoritySolverGA::MajoritySolverGA(const MajoritySolverGA & other) : GeneticAlgorithm(other), currAutomata(nullptr), numFitnessTests(other.numFitnessTests), domainSize(other.domainSize), maxSteps(other.maxSteps), fitnessCache(other.fitnessCache) {}
 
 MajoritySolverGA& MajoritySolverGA::operator=(const MajoritySolverGA & other) {
     if(this != &other){
@@ -192,6 +196,7 @@ MajoritySolverGA& MajoritySolverGA::operator=(const MajoritySolverGA & other) {
         numFitnessTests = other.numFitnessTests;
         domainSize = other.domainSize;
         maxSteps = other.maxSteps;
+        fitnessCache = other.fitnessCache;
     }
     return *this;
 }
@@ -205,6 +210,16 @@ MajoritySolverGA::~MajoritySolverGA() {
 
 //---------- GENETIC ALGORITHM FUNCTIONS ----------
 double MajoritySolverGA::fitness(int member){
+    // A rule that was already tested keeps its fitness
+    uint64_t key = 0;
+    double cached;
+    if(fitnessCache){
+        key = cacheKey(member);
+        if(fitnessCache->lookup(key, cached)){
+            return cached;
+        }
+    }
+
     // Setup the cellular automata
     if(!currAutomata){
         currAutomata = new CellularAutomata1D(population[member]);
@@ -267,7 +282,11 @@ double MajoritySolverGA::fitness(int member){
     delete[](start);
 
     // Return the fitness value
-    return fitness / ((double) numFitnessTests);
+    fitness /= (double) numFitnessTests;
+    if(fitnessCache){
+        fitnessCache->store(key, fitness);
+    }
+    return fitness;
 }
 
 //---------- UTILITIES ----------
@@ -293,6 +312,31 @@ void MajoritySolverGA::visualizeMember(int member){
     currAutomata->snapShot(start, domainSize, maxSteps, CA_PIXEL_SIZE);
 }
 
+//---------- MUTATORS ----------
+void MajoritySolverGA::setFitnessCache(FitnessCache* fitnessCache){
+    this->fitnessCache = fitnessCache;
+}
+
+//---------- PRIVATE UTILITIES ----------
+uint64_t MajoritySolverGA::cacheKey(int member){
+    // The random bit strings are as likely as their mirror images, so mirroring the rule (swapping the left and right neighbors) keeps the expected fitness
+    uint64_t rule = 0;
+    uint64_t mirror = 0;
+    for(int i = 0; i < 8; i++){
+        uint64_t on = population[member][i] == CA_TRUE;
+        rule |= on << i;
+        mirror |= on << (((i & 1) << 2) | (i & 2) | (i >> 2));
+    }
+
+    // The fitness also depends on the number of tests, the size of the domain and the number of steps, every field mixed in on its own like the GameOfLifeGA keys
+    const uint64_t fields[] = {min(rule, mirror), (uint64_t) (uint32_t) numFitnessTests, (uint64_t) (uint32_t) domainSize, (uint64_t) (uint32_t) maxSteps};
+    uint64_t key = 0;
+    for(uint64_t field : fields){
+        key = mixHash(key ^ field);
+    }
+    return key;
+}
+
 //-----------------------------------------------------------------------------
 //---------- WrapInt ----------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -541,8 +585,26 @@ void CellularAutomata1DGeneral::step(bool*& curr, int domainSize){
     // Create a wrapping index value
     WrapInt wrapIndex = WrapInt(0, domainSize);
     
-    // Update all values
+    // Rules as 0 or 1 for the kernels
+    int* table = new int[numRules];
+    for(int i = 0; i < numRules; i++){
+        table[i] = rules[i] == CA_TRUE;
+    }
+
+    // Internals that don't wrap around
+    if(domainSize > 2 * neighborCount){
+        kernels::ca1DGeneralRow(curr + neighborCount, next + neighborCount, domainSize - 2 * neighborCount, neighborCount, table);
+    }
+    delete[](table);
+
+    // Update the values near the edges
     for(int i = 0; i < domainSize; i++){
+        // Skip the internals
+        if(i == neighborCount && domainSize > 2 * neighborCount){
+            i = domainSize - neighborCount - 1;
+            continue;
+        }
+
         // Initial value
         wrapIndex.setVal(i + neighborCount);
 
@@ -1,10 +1,13 @@
 #ifndef CELLULAR_AUTOMATA_H
 #define CELLULAR_AUTOMATA_H
 
+#include <cstdint>
 #include <SDL2/SDL.h>
 
 #include "geneticsolver.h"
 
+class FitnessCache;
+
 // Goal: Use cellular automata and genetic algorithms to determine if a bit string is majority on
 // -> If a given bit string has majority on then the result should be all on, otherwise the result should be all off
 
@@ -76,6 +79,12 @@ class MajoritySolverGA : public GeneticAlgorithm {
         // Creates an animation of the given member
         void visualizeMember(int member);
 
+        //---------- MUTATORS ----------
+        // Takes the fitness of members whose rule, or its mirror image, is in the cache instead of testing them again, and stores the rest
+        // The cache is not owned and can be shared, nullptr (the default) turns it off
+        // Note: the fitness is an estimate from random bit strings, so a cached rule keeps the estimate of its first evaluation
+        void setFitnessCache(FitnessCache* fitnessCache);
+
     private:
         static char CA_ACTIONS[2];
         // Cellular Automata framework for evaluating the fitness
@@ -86,6 +95,12 @@ class MajoritySolverGA : public GeneticAlgorithm {
         int domainSize;
         // The maximum number of steps before the fitness function gives up
         int maxSteps;
+        // Cache of the fitness of rules already tested, nullptr if none
+        FitnessCache* fitnessCache;
+
+        //---------- PRIVATE UTILITIES ----------
+        // Key of the member in the fitness cache, the same for a rule and its mirror image
+        uint64_t cacheKey(int member);
 };
 
 // Super basic integer that is meant to be positive and wrap around if it exceeds the maximum value
@@ -0,0 +1,102 @@
+#include <iostream>
+
+#include "cycledetector.h"
+
+//-------------------------------------------------------------------------------------
+//---------- CycleDetector ------------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+CycleDetector::CycleDetector() : cycleStart(-1), period(-1) {}
+
+CycleDetector::~CycleDetector(){}
+
+//---------- UTILITIES ----------
+void CycleDetector::reset(){
+    seen.clear();
+    cycleStart = -1;
+    period = -1;
+}
+
+bool CycleDetector::record(uint64_t hash, int generation){
+    auto found = seen.emplace(hash, generation);
+    if(found.second){
+        return false;
+    }
+    cycleStart = found.first->second;
+    period = generation - cycleStart;
+    return true;
+}
+
+int CycleDetector::equivalentGeneration(int generation) const{
+    if(generation < cycleStart){
+        return generation;
+    }
+    return cycleStart + (generation - cycleStart) % period;
+}
+
+double CycleDetector::extrapolateSum(const vector<double>& values, int totalSteps) const{
+    // Everything that was actually simulated
+    int last = (int) values.size() - 1;
+    double sum = 0.0;
+    for(int k = 1; k <= min(last, totalSteps); k++){
+        sum += values[k];
+    }
+    if(totalSteps <= last){
+        return sum;
+    }
+
+    // The steps into the generations of the cycle repeat
+    double cycleSum = 0.0;
+    for(int k = cycleStart + 1; k <= cycleStart + period; k++){
+        cycleSum += values[k];
+    }
+    int remaining = totalSteps - last;
+    sum += (remaining / period) * cycleSum;
+    for(int k = cycleStart + 1; k <= cycleStart + remaining % period; k++){
+        sum += values[k];
+    }
+    return sum;
+}
+
+//---------- ACCESSORS ----------
+bool CycleDetector::foundCycle() const{
+    return period > 0;
+}
+
+int CycleDetector::getCycleStart() const{
+    return cycleStart;
+}
+
+int CycleDetector::getPeriod() const{
+    return period;
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_CycleDetector(){
+    // A sequence that runs 0, 1, 2 and then cycles 3, 4, 5, 6 with the value of each step being the generation it leads to
+    uint64_t states[] = {10, 11, 12, 13, 14, 15, 16, 13};
+    CycleDetector detector = CycleDetector();
+    vector<double> values = {0.0};
+    bool passed = true;
+    int generation = 0;
+    for(; generation < 8; generation++){
+        if(generation > 0){
+            values.push_back(states[generation]);
+        }
+        if(detector.record(states[generation], generation)){
+            break;
+        }
+    }
+    passed = passed && generation == 7 && detector.getCycleStart() == 3 && detector.getPeriod() == 4;
+    passed = passed && detector.equivalentGeneration(2) == 2 && detector.equivalentGeneration(100) == 4;
+
+    // Compare the extrapolated sum against running the sequence out
+    for(int totalSteps : {5, 7, 8, 13, 100}){
+        double expected = 0.0;
+        for(int k = 1; k <= totalSteps; k++){
+            expected += states[detector.equivalentGeneration(k)];
+        }
+        passed = passed && detector.extrapolateSum(values, totalSteps) == expected;
+    }
+    cout << "CycleDetector: " << (passed ? "PASSED" : "FAILED") << "\n";
+}
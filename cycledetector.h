@@ -0,0 +1,55 @@
+#ifndef CYCLE_DETECTOR_H
+#define CYCLE_DETECTOR_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/*
+Cycle Detector
+
+Watches the hashes of the states of a deterministic simulation, one per generation, and spots the first time a state comes back. From then on the simulation is known to repeat with a fixed period forever, which covers dying out (the empty board repeats with period 1), settling into still lifes (period 1) and oscillators of any period.
+
+Once a cycle is found the rest of a long simulation can be worked out without running it: any later generation is equivalent to one that was already seen, and any per-step value that only depends on the states repeats with the same period.
+
+Hashes are 64 bits and collisions are assumed never to happen.
+*/
+
+class CycleDetector{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        CycleDetector();
+        ~CycleDetector();
+
+        //---------- UTILITIES ----------
+        // Forgets every state
+        void reset();
+        // Records the hash of the state at the generation, returns true if the state was seen before - the cycle is known from then on
+        // Generations must be recorded in order starting at 0
+        bool record(uint64_t hash, int generation);
+        // Returns the earlier generation with the same state as the generation, only valid once a cycle was found
+        int equivalentGeneration(int generation) const;
+        // Sums values[1] to values[totalSteps] where values[k] is the value of the step into generation k, extending the recorded values around the cycle
+        // Only valid once a cycle was found and values holds every generation up to the one that closed the cycle
+        double extrapolateSum(const vector<double>& values, int totalSteps) const;
+
+        //---------- ACCESSORS ----------
+        bool foundCycle() const;
+        // First generation of the cycle, -1 if there is no cycle yet
+        int getCycleStart() const;
+        // Length of the cycle, -1 if there is no cycle yet
+        int getPeriod() const;
+    private:
+        // Generation each state was first seen at
+        unordered_map<uint64_t, int> seen;
+        // The cycle
+        int cycleStart;
+        int period;
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_CycleDetector();
+
+#endif
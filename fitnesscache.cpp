@@ -0,0 +1,302 @@
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "fitnesscache.h"
+#include "bitutils.h"
+#include "gameoflife.h"
+#include "cellularautomata.h"
+#include "rng.h"
+
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+FitnessCache::FitnessCache() : FitnessCache(FITNESS_CACHE_DEFAULT_CAPACITY) {}
+
+FitnessCache::FitnessCache(size_t capacity) : capacity(max((size_t) 1, capacity)), hits(0), misses(0), evictions(0) {
+    index.reserve(this->capacity);
+}
+
+FitnessCache::~FitnessCache(){}
+
+//---------- UTILITIES ----------
+bool FitnessCache::lookup(uint64_t key, double& fitness){
+    lock_guard<mutex> guard(lock);
+    auto found = index.find(key);
+    if(found == index.end()){
+        misses++;
+        return false;
+    }
+
+    // Move the entry to the front of the list
+    entries.splice(entries.begin(), entries, found->second);
+    fitness = found->second->second;
+    hits++;
+    return true;
+}
+
+void FitnessCache::store(uint64_t key, double fitness){
+    lock_guard<mutex> guard(lock);
+    auto found = index.find(key);
+    if(found != index.end()){
+        found->second->second = fitness;
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+
+    // Make room by dropping the least recently used entry
+    if(entries.size() >= capacity){
+        index.erase(entries.back().first);
+        entries.pop_back();
+        evictions++;
+    }
+    entries.emplace_front(key, fitness);
+    index[key] = entries.begin();
+}
+
+void FitnessCache::clear(){
+    lock_guard<mutex> guard(lock);
+    entries.clear();
+    index.clear();
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+}
+
+//---------- ACCESSORS ----------
+size_t FitnessCache::getCapacity() const{
+    return capacity;
+}
+
+size_t FitnessCache::getSize(){
+    lock_guard<mutex> guard(lock);
+    return entries.size();
+}
+
+long long FitnessCache::getHits(){
+    lock_guard<mutex> guard(lock);
+    return hits;
+}
+
+long long FitnessCache::getMisses(){
+    lock_guard<mutex> guard(lock);
+    return misses;
+}
+
+long long FitnessCache::getEvictions(){
+    lock_guard<mutex> guard(lock);
+    return evictions;
+}
+
+double FitnessCache::getHitRate(){
+    lock_guard<mutex> guard(lock);
+    long long lookups = hits + misses;
+    return lookups == 0 ? 0.0 : ((double) hits) / ((double) lookups);
+}
+
+//---------- FUNCTIONS ----------
+uint64_t canonicalOrganismHash(const char* organism, int orgRows, int orgCols, bool translations, int numSymmetries){
+    // Box of the cells that are on, the whole organism without translations
+    int top = 0;
+    int bottom = orgRows - 1;
+    int left = 0;
+    int right = orgCols - 1;
+    if(translations){
+        top = orgRows;
+        bottom = -1;
+        left = orgCols;
+        right = -1;
+        for(int i = 0; i < orgRows; i++){
+            for(int j = 0; j < orgCols; j++){
+                if(organism[i * orgCols + j]){
+                    top = min(top, i);
+                    bottom = max(bottom, i);
+                    left = min(left, j);
+                    right = max(right, j);
+                }
+            }
+        }
+
+        // Every empty organism is the same
+        if(bottom < 0){
+            return mixHash(0);
+        }
+    }
+    int rows = bottom - top + 1;
+    int cols = right - left + 1;
+
+    uint64_t best = UINT64_MAX;
+    for(int s = 0; s < numSymmetries; s++){
+        // The first four keep the shape, the last four swap the rows and columns
+        bool swap = s >= 4;
+        int imageRows = swap ? cols : rows;
+        int imageCols = swap ? rows : cols;
+        uint64_t hash = mixHash(((uint64_t) imageRows << 32) | (uint64_t) imageCols);
+        uint64_t word = 0;
+        int bits = 0;
+        for(int i = 0; i < imageRows; i++){
+            for(int j = 0; j < imageCols; j++){
+                // Cell of the box the cell of the image comes from, flipping the rows with bit 0 and the columns with bit 1 of the symmetry
+                int row = swap ? j : i;
+                int col = swap ? i : j;
+                row = (s & 1) ? rows - 1 - row : row;
+                col = (s & 2) ? cols - 1 - col : col;
+                word |= (uint64_t) (organism[(top + row) * orgCols + left + col] != 0) << bits;
+
+                // Every full word goes through the finalizer along with the hash so far
+                if(++bits == 64){
+                    hash = mixHash(hash ^ word);
+                    word = 0;
+                    bits = 0;
+                }
+            }
+        }
+        hash = mixHash(hash ^ word);
+        best = min(best, hash);
+    }
+    return best;
+}
+
+// Genetic algorithm whose members can be written directly, for building populations of related organisms
+class PopulationGA : public GameOfLifeGA {
+    public:
+        using GameOfLifeGA::GameOfLifeGA;
+
+        void setMember(int member, const char* organism){
+            memcpy(population[member], organism, sizeMembers);
+        }
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_FitnessCache(){
+    // The least recently used entry should be dropped once the cache is full
+    FitnessCache cache = FitnessCache(3);
+    double value = 0.0;
+    cache.store(1, 1.0);
+    cache.store(2, 2.0);
+    cache.store(3, 3.0);
+    bool passed = cache.lookup(1, value) && value == 1.0;
+    cache.store(4, 4.0);
+    passed = passed && !cache.lookup(2, value) && cache.lookup(3, value) && value == 3.0 && cache.lookup(4, value) && value == 4.0;
+    cache.store(1, 1.5);
+    passed = passed && cache.lookup(1, value) && value == 1.5 && cache.getSize() == 3;
+    passed = passed && cache.getHits() == 4 && cache.getMisses() == 1 && cache.getEvictions() == 1;
+    cache.clear();
+    passed = passed && !cache.lookup(1, value) && cache.getSize() == 0 && cache.getMisses() == 1;
+    cout << "Fitness cache LRU: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Every image of an organism should hash the same, shapes that are not images of each other should not
+    const int size = 5;
+    char glider[size * size] = {};
+    glider[0 * size + 2] = 1;
+    glider[1 * size + 3] = 1;
+    glider[2 * size + 1] = 1;
+    glider[2 * size + 2] = 1;
+    glider[2 * size + 3] = 1;
+    uint64_t hash = canonicalOrganismHash(glider, size, size, true, 8);
+    passed = true;
+    for(int s = 0; s < 8; s++){
+        // Turn or reflect the glider and move it to a random place in the box
+        char image[size * size] = {};
+        int shiftRow = rng::genRandInt(0, 1);
+        int shiftCol = rng::genRandInt(0, 1);
+        for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++){
+                int row = s >= 4 ? j : i;
+                int col = s >= 4 ? i : j;
+                row = (s & 1) ? 2 - row : row;
+                col = (s & 2) ? 2 - col : col;
+                image[(shiftRow + i) * size + shiftCol + j] = glider[row * size + col + 1];
+            }
+        }
+        passed = passed && canonicalOrganismHash(image, size, size, true, 8) == hash;
+    }
+    char blinker[size * size] = {};
+    blinker[2 * size + 1] = 1;
+    blinker[2 * size + 2] = 1;
+    blinker[2 * size + 3] = 1;
+    char moved[size * size] = {};
+    moved[3 * size + 1] = 1;
+    moved[3 * size + 2] = 1;
+    moved[3 * size + 3] = 1;
+    passed = passed && canonicalOrganismHash(blinker, size, size, true, 8) != hash;
+    passed = passed && canonicalOrganismHash(blinker, size, size, true, 1) == canonicalOrganismHash(moved, size, size, true, 1);
+    passed = passed && canonicalOrganismHash(blinker, size, size, false, 1) != canonicalOrganismHash(moved, size, size, false, 1);
+    cout << "Fitness cache symmetries: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // The GameOfLifeGA should give the same fitness with the cache, the symmetric members taking the fitness of another image
+    // Half of every population is a turned or reflected copy of the other half, and evaluating it again should be all hits
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::CenterOfMassMotion, GoLFitnessFunction::Lifespan};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "CenterOfMassMotion", "Lifespan"};
+    GoLBoundary boundaries[] = {GoLBoundary::Toroidal, GoLBoundary::Unbounded};
+    const char* boundaryNames[] = {"torus", "unbounded"};
+    FitnessCache shared;
+    for(int b = 0; b < 2; b++){
+        for(int f = 0; f < 4; f++){
+            shared.clear();
+            PopulationGA plain = PopulationGA(100, 9 * 9, 2, actions, 1, 0.005, 1, 27, 27, functions[f], 200, 9, 9, boundaries[b]);
+
+            // Keep the middle 7 x 7 of the first half and make the second half out of images of it
+            for(int member = 0; member < 100; member++){
+                char* source = plain.getMember(member % 50);
+                char image[9 * 9] = {};
+                int s = member < 50 ? 0 : rng::genRandInt(0, 7);
+                for(int i = 0; i < 7; i++){
+                    for(int j = 0; j < 7; j++){
+                        int row = s >= 4 ? j : i;
+                        int col = s >= 4 ? i : j;
+                        row = (s & 1) ? 6 - row : row;
+                        col = (s & 2) ? 6 - col : col;
+                        image[(i + 1) * 9 + j + 1] = source[(row + 1) * 9 + col + 1];
+                    }
+                }
+                plain.setMember(member, image);
+                delete[](source);
+            }
+
+            GameOfLifeGA cached = GameOfLifeGA(plain);
+            cached.setFitnessCache(&shared);
+            auto start = chrono::steady_clock::now();
+            plain.evalFitness();
+            auto middle = chrono::steady_clock::now();
+            cached.evalFitness();
+            auto end = chrono::steady_clock::now();
+            cached.evalFitness();
+
+            passed = shared.getHits() == 100 && shared.getMisses() == (long long) shared.getSize();
+            for(int member = 0; member < 100 && passed; member++){
+                double expected = plain.getFitness(member);
+                passed = fabs(cached.getFitness(member) - expected) <= 1e-9 * max(1.0, fabs(expected));
+                passed = passed && cached.fitness(member) == cached.getFitness(member);
+            }
+            cout << "Fitness cache " << names[f] << " " << boundaryNames[b] << ": " << (passed ? "PASSED" : "FAILED") << ", " << shared.getSize() << " organisms for 100 members, hit rate " << shared.getHitRate() << ", without " << chrono::duration<double>(middle - start).count() << "s, with " << chrono::duration<double>(end - middle).count() << "s\n";
+        }
+    }
+
+    // Settings that only differ together, here the columns and a high bit of the number of steps, should not share entries
+    PopulationGA wide = PopulationGA(20, 9 * 9, 2, actions, 1, 0.005, 1, 27, 27, GoLFitnessFunction::CenterOfMassMotion, 150, 9, 9);
+    PopulationGA narrow = PopulationGA(20, 9 * 9, 2, actions, 1, 0.005, 1, 27, 26, GoLFitnessFunction::CenterOfMassMotion, 150 ^ (1 << 16), 9, 9);
+    for(int member = 0; member < 20; member++){
+        char* memArr = wide.getMember(member);
+        narrow.setMember(member, memArr);
+        delete[](memArr);
+    }
+    shared.clear();
+    wide.setFitnessCache(&shared);
+    narrow.setFitnessCache(&shared);
+    wide.evalFitness();
+    long long stored = shared.getMisses();
+    narrow.evalFitness();
+    passed = shared.getHits() == 0 && shared.getMisses() == 2 * stored;
+    cout << "Fitness cache settings: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // The MajoritySolverGA should test a rule and its mirror image once
+    MajoritySolverGA majority = MajoritySolverGA(50, 1, 0.1, 20, 59, 100);
+    FitnessCache rules;
+    majority.setFitnessCache(&rules);
+    majority.evalFitness();
+    long long tested = rules.getMisses();
+    majority.evalFitness();
+    passed = rules.getMisses() == tested && rules.getHits() >= 50 && (long long) rules.getSize() == tested;
+    cout << "Fitness cache MajoritySolverGA: " << (passed ? "PASSED" : "FAILED") << ", " << rules.getSize() << " rules for 50 members\n";
+}
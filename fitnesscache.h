@@ -0,0 +1,77 @@
+#ifndef FITNESS_CACHE_H
+#define FITNESS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+
+/*
+Fitness Cache
+
+Remembers the fitness of the most recently evaluated genomes. Crossover and low mutation rates keep producing members that were already evaluated, and for problems whose fitness does not change under some symmetry of the genome (a rotated or reflected Game of Life organism, a mirrored cellular automata rule) every image of a genome can share one entry by keying on a canonical hash of it.
+
+The cache holds at most a fixed number of entries and drops the least recently used one to make room, so its memory use is bounded however long the algorithm runs. Every call takes a single lock so threads evaluating a population at the same time can share one cache.
+
+Keys are 64 bit hashes and collisions are assumed never to happen, the caller mixes anything else the fitness depends on into the key.
+*/
+
+//---------- CONSTANTS ----------
+// Number of entries of a cache made with the default constructor
+const size_t FITNESS_CACHE_DEFAULT_CAPACITY = 1 << 16;
+
+class FitnessCache{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        FitnessCache();
+        FitnessCache(size_t capacity);
+        // The lock can not be copied
+        FitnessCache(const FitnessCache & other) = delete;
+        FitnessCache& operator=(const FitnessCache & other) = delete;
+        ~FitnessCache();
+
+        //---------- UTILITIES ----------
+        // Looks up the fitness stored for the key, making it the most recently used, returns false if there is none
+        bool lookup(uint64_t key, double& fitness);
+        // Stores the fitness for the key, dropping the least recently used entry if the cache is full
+        void store(uint64_t key, double fitness);
+        // Drops every entry and resets the counters
+        void clear();
+
+        //---------- ACCESSORS ----------
+        size_t getCapacity() const;
+        size_t getSize();
+        long long getHits();
+        long long getMisses();
+        long long getEvictions();
+        // Fraction of the lookups that found a fitness, 0 if there were none
+        double getHitRate();
+    private:
+        // Maximum number of entries
+        size_t capacity;
+        // Entries from the most recently used to the least
+        list<pair<uint64_t, double>> entries;
+        // Where the entry of every key is in the list
+        unordered_map<uint64_t, list<pair<uint64_t, double>>::iterator> index;
+        // Protects everything above and the counters
+        mutex lock;
+        // Counters
+        long long hits;
+        long long misses;
+        long long evictions;
+};
+
+//---------- FUNCTIONS ----------
+// Hash of the orgRows x orgCols organism (cells that are not 0 are on) that is the same for every image of it under the symmetries
+// With translations the organism is first cropped to the cells that are on, then the smallest hash of its images under the first numSymmetries is taken
+// The symmetries are the identity, the two reflections and the half turn (1 or 4 keeps the shape of a rectangle) followed by the two diagonal reflections and the two quarter turns (8 for all of the square)
+// Note: the last four swap the rows and columns, so they need translations unless the organism is square
+uint64_t canonicalOrganismHash(const char* organism, int orgRows, int orgCols, bool translations, int numSymmetries);
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_FitnessCache();
+
+#endif
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <iostream>
+
+#include "rng.h"
+#include "fixedgameoflife.h"
+
+//-------------------------------------------------------------------------------------
+//---------- FixedLife ----------------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+FixedLife::~FixedLife(){}
+
+//---------- HELPER FUNCTIONS ----------
+// Steps a fixed size board and a GameOfLife from the same random board, returns true if they stay the same
+static bool matchesGameOfLife(FixedLife& fixed, int numSteps){
+    int rows = fixed.getRows();
+    int cols = fixed.getCols();
+    GameOfLife game = GameOfLife(rows, cols);
+    game.setHashing(true);
+    game.setStatistics(true);
+    game.randomBoard(0.4);
+    fixed.setBoard(game.getBoard());
+
+    bool passed = true;
+    for(int k = 0; k <= numSteps && passed; k++){
+        if(k > 0){
+            passed = fixed.step() == game.step();
+        }
+        bool** board = game.getBoard();
+        for(int i = 0; i < rows && passed; i++){
+            for(int j = 0; j < cols && passed; j++){
+                passed = fixed.getCell(i, j) == board[i][j];
+            }
+        }
+        GoLStatistics fixedStats = fixed.getStatistics();
+        GoLStatistics stats = game.getStatistics();
+        passed = passed && fixedStats.population == stats.population && fixedStats.rowSum == stats.rowSum && fixedStats.colSum == stats.colSum;
+        passed = passed && fixedStats.minRow == stats.minRow && fixedStats.maxRow == stats.maxRow && fixedStats.minCol == stats.minCol && fixedStats.maxCol == stats.maxCol;
+    }
+    return passed;
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_FixedGameOfLife(){
+    // Boards of a few shapes, including a full word and single rows and columns, should step the same as the GameOfLife class
+    FixedGameOfLife<27, 27> square;
+    FixedGameOfLife<16, 64> wide;
+    FixedGameOfLife<40, 7> tall;
+    FixedGameOfLife<1, 9> row;
+    FixedGameOfLife<9, 1> column;
+    FixedLife* boards[] = {&square, &wide, &tall, &row, &column};
+    bool passed = true;
+    for(int b = 0; b < 5 && passed; b++){
+        passed = matchesGameOfLife(*boards[b], 200);
+    }
+    cout << "Fixed size step: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Copies should be independent and hash the same as the original
+    char glider[] = {0, 1, 0, 0, 0, 1, 1, 1, 1};
+    square.addOrganism(3, 3, glider);
+    uint64_t hash = square.getHash();
+    FixedLife* copy = square.clone();
+    passed = copy->getHash() == hash;
+    long long changes = square.step();
+    passed = passed && square.getHash() != hash && copy->getHash() == hash;
+    passed = passed && copy->step() == changes && copy->getHash() == square.getHash();
+    delete(copy);
+    cout << "Fixed size clone: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // The GameOfLifeGA should give the same fitness with the fixed size board, one member at a time
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::CenterOfMassMotion, GoLFitnessFunction::Lifespan};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "CenterOfMassMotion", "Lifespan"};
+    for(int f = 0; f < 4; f++){
+        GameOfLifeGA plain = GameOfLifeGA(100, 13 * 13, 2, actions, 1, 0.1, 1, 27, 27, functions[f], 300, 13, 13);
+        plain.setBatching(false);
+        GameOfLifeGA fixed = GameOfLifeGA(plain);
+        fixed.setFixedBoard(new FixedGameOfLife<27, 27>());
+
+        auto start = chrono::steady_clock::now();
+        plain.evalFitness();
+        auto middle = chrono::steady_clock::now();
+        fixed.evalFitness();
+        auto end = chrono::steady_clock::now();
+
+        passed = true;
+        for(int member = 0; member < 100 && passed; member++){
+            passed = plain.getFitness(member) == fixed.getFitness(member);
+        }
+        cout << "Fixed size " << names[f] << ": " << (passed ? "PASSED" : "FAILED") << ", GameOfLife " << chrono::duration<double>(middle - start).count() << "s, FixedGameOfLife " << chrono::duration<double>(end - middle).count() << "s\n";
+    }
+}
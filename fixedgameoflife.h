@@ -0,0 +1,204 @@
+#ifndef FIXED_GAME_OF_LIFE_H
+#define FIXED_GAME_OF_LIFE_H
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+#include "gameoflife.h"
+#include "bitgameoflife.h"
+#include "bitutils.h"
+
+using namespace std;
+
+/*
+Fixed Size Game of Life
+
+FixedGameOfLife<Rows, Cols> is a toroidal Game of Life board whose size is part of the type. Every row is a single word held inside the object, so a 27 x 27 genetic algorithm board takes 216 bytes - a few cache lines - and is never allocated on its own. The step loops have constant bounds and are unrolled, and the wrap around of the torus becomes a pair of rotations of each row word.
+
+The results are identical to the GameOfLife class on the same board. Only Conway's rule is run and Cols can be at most 64.
+
+FixedLife is the interface the boards share, so code that only knows the size at runtime, like GameOfLifeGA, can be handed a board made where the size is known at compile time:
+    ga.setFixedBoard(new FixedGameOfLife<GOLS_SIM_ROWS, GOLS_SIM_COLS>());
+*/
+
+class FixedLife{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        virtual ~FixedLife();
+        // Creates a copy of the board of the same size, the caller owns the copy
+        virtual FixedLife* clone() const = 0;
+
+        //---------- UTILITIES ----------
+        // Clears the board and adds the organism in the same place GameOfLife::addOrganism puts it. Allows for both bool arrays and char arrays which match the genetic algorithm code
+        virtual void addOrganism(int orgRows, int orgCols, bool* organism) = 0;
+        virtual void addOrganism(int orgRows, int orgCols, char* organism) = 0;
+        // Performs a single step of the game of life counting the net number of tiles changed
+        virtual long long step() = 0;
+        // Creates a copy of the board overwriting the data
+        virtual void getBoardSafe(bool** data) const = 0;
+        // Overwrites the board with the data
+        virtual void setBoard(bool** data) = 0;
+
+        //---------- ACCESSORS ----------
+        virtual int getRows() const = 0;
+        virtual int getCols() const = 0;
+        virtual bool getCell(int row, int col) const = 0;
+        virtual long long getPopulation() const = 0;
+        // Population, index sums and bounding box of the cells that are on, the same as GameOfLife::getStatistics()
+        virtual GoLStatistics getStatistics() const = 0;
+        // Returns a 64 bit hash of the board, boards hash the same exactly when they are the same (barring collisions)
+        // Note: not the same values as GameOfLife::getHash()
+        virtual uint64_t getHash() const = 0;
+};
+
+template<int Rows, int Cols>
+class FixedGameOfLife : public FixedLife {
+    static_assert(Rows >= 1 && Cols >= 1 && Cols <= BIT_GAME_OF_LIFE_WORD_BITS, "a row of a FixedGameOfLife has to fit in a word");
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        FixedGameOfLife(){
+            memset(board, 0, sizeof(board));
+        }
+
+        FixedLife* clone() const{
+            return new FixedGameOfLife<Rows, Cols>(*this);
+        }
+
+        //---------- UTILITIES ----------
+        void addOrganism(int orgRows, int orgCols, bool* organism){
+            memset(board, 0, sizeof(board));
+
+            // Copy the organism into roughly the center of the board
+            int rowPad = (Rows - orgRows) / 2;
+            int colPad = (Cols - orgCols) / 2;
+            for(int i = 0; i < orgRows; i++){
+                for(int j = 0; j < orgCols; j++){
+                    board[rowPad + i] |= (uint64_t) organism[i * orgCols + j] << (colPad + j);
+                }
+            }
+        }
+
+        void addOrganism(int orgRows, int orgCols, char* organism){
+            memset(board, 0, sizeof(board));
+
+            // Copy the organism into roughly the center of the board
+            int rowPad = (Rows - orgRows) / 2;
+            int colPad = (Cols - orgCols) / 2;
+            for(int i = 0; i < orgRows; i++){
+                for(int j = 0; j < orgCols; j++){
+                    board[rowPad + i] |= (uint64_t) (organism[i * orgCols + j] != 0) << (colPad + j);
+                }
+            }
+        }
+
+        long long step(){
+            // Neighbors to the west and east of every cell, wrapping around the row
+            uint64_t west[Rows];
+            uint64_t east[Rows];
+            #pragma GCC unroll 64
+            for(int i = 0; i < Rows; i++){
+                west[i] = ((board[i] << 1) | (board[i] >> (Cols - 1))) & ROW_MASK;
+                east[i] = (board[i] >> 1) | ((board[i] & 1) << (Cols - 1));
+            }
+
+            // Apply rules of Conway's Game of Life to a whole row at once
+            long long count = 0;
+            uint64_t next[Rows];
+            #pragma GCC unroll 64
+            for(int i = 0; i < Rows; i++){
+                int up = i == 0 ? Rows - 1 : i - 1;
+                int down = i == Rows - 1 ? 0 : i + 1;
+                next[i] = lifeWord(west[up], board[up], east[up], west[i], board[i], east[i], west[down], board[down], east[down]);
+                count += __builtin_popcountll(next[i] ^ board[i]);
+            }
+            memcpy(board, next, sizeof(board));
+            return count;
+        }
+
+        void getBoardSafe(bool** data) const{
+            for(int i = 0; i < Rows; i++){
+                for(int j = 0; j < Cols; j++){
+                    data[i][j] = (board[i] >> j) & 1;
+                }
+            }
+        }
+
+        void setBoard(bool** data){
+            for(int i = 0; i < Rows; i++){
+                board[i] = 0;
+                for(int j = 0; j < Cols; j++){
+                    board[i] |= (uint64_t) data[i][j] << j;
+                }
+            }
+        }
+
+        //---------- ACCESSORS ----------
+        int getRows() const{
+            return Rows;
+        }
+
+        int getCols() const{
+            return Cols;
+        }
+
+        bool getCell(int row, int col) const{
+            return (board[row] >> col) & 1;
+        }
+
+        long long getPopulation() const{
+            long long count = 0;
+            for(int i = 0; i < Rows; i++){
+                count += __builtin_popcountll(board[i]);
+            }
+            return count;
+        }
+
+        GoLStatistics getStatistics() const{
+            GoLStatistics stats;
+            for(int i = 0; i < Rows; i++){
+                uint64_t word = board[i];
+                if(word == 0){
+                    continue;
+                }
+                long long count = __builtin_popcountll(word);
+                stats.population += count;
+                stats.rowSum += count * i;
+                stats.minRow = min(stats.minRow, i);
+                stats.maxRow = i;
+                stats.minCol = min(stats.minCol, __builtin_ctzll(word));
+                stats.maxCol = max(stats.maxCol, BIT_GAME_OF_LIFE_WORD_BITS - 1 - __builtin_clzll(word));
+
+                // Sum of the set bit positions, one bit of the position at a time
+                for(int b = 0; b < 6; b++){
+                    stats.colSum += (long long) __builtin_popcountll(word & POSITION_BITS[b]) << b;
+                }
+            }
+            return stats;
+        }
+
+        uint64_t getHash() const{
+            // Every row goes through the finalizer of SplitMix64 along with the hash so far, so the order of the rows matters
+            uint64_t hash = 0;
+            for(int i = 0; i < Rows; i++){
+                hash ^= board[i];
+                hash ^= hash >> 30;
+                hash *= 0xBF58476D1CE4E5B9ULL;
+                hash ^= hash >> 27;
+                hash *= 0x94D049BB133111EBULL;
+                hash ^= hash >> 31;
+            }
+            return hash;
+        }
+    private:
+        // Mask of the columns of a row
+        static constexpr uint64_t ROW_MASK = Cols == BIT_GAME_OF_LIFE_WORD_BITS ? ~((uint64_t) 0) : (((uint64_t) 1) << Cols) - 1;
+
+        // The board itself, bit j of board[i] holds column j of row i
+        uint64_t board[Rows];
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_FixedGameOfLife();
+
+#endif
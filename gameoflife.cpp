@@ -1,36 +1,132 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <unordered_map>
 
 #include "rng.h"
+#include "kernels.h"
 #include "gameoflife.h"
+#include "bitutils.h"
+#include "bitgameoflife.h"
+#include "batchgameoflife.h"
+#include "lifeengine.h"
+#include "fixedgameoflife.h"
+#include "autotune.h"
+#include "transpositiontable.h"
+#include "fitnesscache.h"
 #include "sdl-basics.h"
 
+//---------- HELPER FUNCTIONS ----------
+// Hashes the n cells starting at the position (row * cols + col) of the board, skipping 8 cells at a time where they are all off
+// Every cell that is on adds the hash of its own position, so the hash of the board does not depend on how the tiles split it up and any empty stretch hashes to 0
+static inline uint64_t hashCells(const bool* cells, int n, uint64_t position){
+    uint64_t hash = 0;
+    for(int j = 0; j < n; j += 8){
+        uint64_t word = 0;
+        memcpy(&word, cells + j, min(8, n - j));
+
+        // Every cell that is on is a single set bit at the bottom of its byte, offset by one as the position 0 would hash to 0
+        while(word){
+            hash ^= mixHash(position + j + (__builtin_ctzll(word) >> 3) + 1);
+            word &= word - 1;
+        }
+    }
+    return hash;
+}
+
+// Hash of the cells in the rows [rowStart, rowEnd) and columns [colStart, colStart + width) of a board with cols columns
+static uint64_t hashTile(bool** board, int rowStart, int rowEnd, int colStart, int width, int cols){
+    uint64_t hash = 0;
+    for(int i = rowStart; i < rowEnd; i++){
+        hash ^= hashCells(board[i] + colStart, width, (uint64_t) i * cols + colStart);
+    }
+    return hash;
+}
+
+// Statistics of the cells that are on in the rows [rowStart, rowEnd) and columns [colStart, colStart + width) of the board
+static GoLStatistics countTile(bool** board, int rowStart, int rowEnd, int colStart, int width){
+    GoLStatistics stats;
+    for(int i = rowStart; i < rowEnd; i++){
+        long long count = 0;
+        long long colSum = 0;
+        for(int j = 0; j < width; j += 8){
+            uint64_t word = 0;
+            memcpy(&word, board[i] + colStart + j, min(8, width - j));
+
+            // Every cell that is on is a single set bit at the bottom of its byte
+            while(word){
+                int col = colStart + j + (__builtin_ctzll(word) >> 3);
+                count++;
+                colSum += col;
+                stats.minCol = min(stats.minCol, col);
+                stats.maxCol = max(stats.maxCol, col);
+                word &= word - 1;
+            }
+        }
+        if(count){
+            stats.population += count;
+            stats.rowSum += count * i;
+            stats.colSum += colSum;
+            stats.minRow = min(stats.minRow, i);
+            stats.maxRow = i;
+        }
+    }
+    return stats;
+}
+
+// Steps the rows x cols torus with Conway's rule one cell at a time into next, returning the number of cells changed
+// Shares nothing with the tiles, kernels and hashes of GameOfLife so the tests can hold them to it
+static int referenceStep(const vector<char>& cells, vector<char>& next, int rows, int cols){
+    int changes = 0;
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            int neighbors = 0;
+            for(int di = -1; di <= 1; di++){
+                for(int dj = -1; dj <= 1; dj++){
+                    if(di != 0 || dj != 0){
+                        neighbors += cells[((i + di + rows) % rows) * cols + (j + dj + cols) % cols];
+                    }
+                }
+            }
+            bool alive = cells[i * cols + j];
+            next[i * cols + j] = neighbors == 3 || (alive && neighbors == 2);
+            changes += next[i * cols + j] != alive;
+        }
+    }
+    return changes;
+}
+
 //-------------------------------------------------------------------------------------
 //---------- GameOfLife ---------------------------------------------------------------
 //-------------------------------------------------------------------------------------
 //---------- CONSTRUCTORS & DESTRUCTOR ----------
-GameOfLife::GameOfLife() : rows(GAME_OF_LIFE_DEFAULT_ROWS), cols(GAME_OF_LIFE_DEFAULT_COLS), board(nullptr) {
-    rng::seedRNG();
-    resetBoard();
-}
+GameOfLife::GameOfLife() : GameOfLife(GAME_OF_LIFE_DEFAULT_ROWS, GAME_OF_LIFE_DEFAULT_COLS) {}
 
-GameOfLife::GameOfLife(int rows, int cols) : rows(rows), cols(cols), board(nullptr)  {
+GameOfLife::GameOfLife(int rows, int cols) : rows(rows), cols(cols), board(nullptr), nextBoard(nullptr), boardData(nullptr), nextBoardData(nullptr), stride(0), rule(findLifeRule(ConwayRule::birth, ConwayRule::survive)), kernel(GoLKernel::Rows), blockTable(nullptr), tileSize(GAME_OF_LIFE_DEFAULT_TILE_SIZE), tileRows(0), tileCols(0), tileActive(nullptr), tileDirty(nullptr), tileChanges(nullptr), numActive(0), tilesValid(false), scratchRow(nullptr), pool(nullptr), bandChanges(nullptr), front(0), hashing(false), tileHashes(nullptr), boardHashes{0, 0}, hashValid{false, false}, bandHashes(nullptr), statistics(false), tileStatistics(nullptr), statisticsValid{false, false}, coneActive(false), coneTop(0), coneBottom(0), coneLeft(0), coneRight(0) {
     rng::seedRNG();
+    allocBoard();
     resetBoard();
-}
 
-GameOfLife::GameOfLife(const GameOfLife & other) : rows(other.rows), cols(other.cols), board(nullptr)  {
-    // Delete the old board
-    deleteBoard();
+    // Use the settings found fastest for boards of this size on this machine, if it has been tuned
+    GoLTuning tuning;
+    if(findTuning(rows, cols, tuning)){
+        setTileSize(tuning.tileSize);
+        setThreads(tuning.threads);
+        setKernel(tuning.kernel);
+    }
+}
 
+GameOfLife::GameOfLife(const GameOfLife & other) : rows(other.rows), cols(other.cols), board(nullptr), nextBoard(nullptr), boardData(nullptr), nextBoardData(nullptr), stride(0), rule(other.rule), kernel(other.kernel), blockTable(other.blockTable), tileSize(other.tileSize), tileRows(0), tileCols(0), tileActive(nullptr), tileDirty(nullptr), tileChanges(nullptr), numActive(0), tilesValid(false), scratchRow(nullptr), pool(nullptr), bandChanges(nullptr), front(0), hashing(other.hashing), tileHashes(nullptr), boardHashes{0, 0}, hashValid{false, false}, bandHashes(nullptr), statistics(other.statistics), tileStatistics(nullptr), statisticsValid{false, false}, coneActive(false), coneTop(0), coneBottom(0), coneLeft(0), coneRight(0) {
     // Deep copy the board
-    board = new bool*[rows];
-    for(int i = 0; i < rows; i++){
-        board[i] = new bool[cols];
-        for(int j = 0; j < cols; j++){
-            board[i][j] = other.board[i][j];
-        }
+    if(other.pool){
+        pool = new ThreadPool(other.pool->getNumThreads());
     }
+    allocBoard();
+    memcpy(boardData, other.boardData, (rows + 2) * stride);
 }
 
 GameOfLife& GameOfLife::operator=(const GameOfLife & other){
@@ -41,19 +137,30 @@ GameOfLife& GameOfLife::operator=(const GameOfLife & other){
         // Deep copy the board
         rows = other.rows;
         cols = other.cols;
-        board = new bool*[rows];
-        for(int i = 0; i < rows; i++){
-            board[i] = new bool[cols];
-            for(int j = 0; j < cols; j++){
-                board[i][j] = other.board[i][j];
-            }
+        tileSize = other.tileSize;
+        rule = other.rule;
+        kernel = other.kernel;
+        hashing = other.hashing;
+        statistics = other.statistics;
+        blockTable = other.blockTable;
+        if(pool){
+            delete(pool);
+            pool = nullptr;
         }
+        if(other.pool){
+            pool = new ThreadPool(other.pool->getNumThreads());
+        }
+        allocBoard();
+        memcpy(boardData, other.boardData, (rows + 2) * stride);
     }
     return *this;
 }
 
 GameOfLife::~GameOfLife(){
     deleteBoard();
+    if(pool){
+        delete(pool);
+    }
 }
 
 //---------- UTILITIES ----------
@@ -71,6 +178,9 @@ void GameOfLife::addOrganism(int orgRows, int orgCols, bool* organism){
             index++;
         }
     }
+
+    // Nothing outside of the organism can change until its influence spreads there
+    startLightCone(rowPad, rowPad + orgRows, colPad, colPad + orgCols);
 }
 
 void GameOfLife::addOrganism(int orgRows, int orgCols, char* organism){
@@ -87,19 +197,14 @@ void GameOfLife::addOrganism(int orgRows, int orgCols, char* organism){
             index++;
         }
     }
+
+    // Nothing outside of the organism can change until its influence spreads there
+    startLightCone(rowPad, rowPad + orgRows, colPad, colPad + orgCols);
 }
 
 void GameOfLife::randomBoard(double chance){
     // Roll for determining if a square is on
     double roll;
-    
-    // Allocate memory for the board if necessary
-    if(!board){
-        board = new bool*[rows];
-        for(int i = 0; i < rows; i++){
-            board[i] = new bool[cols];
-        }
-    }
 
     // Fill out the board
     for(int i = 0; i < rows; i++){
@@ -110,204 +215,128 @@ void GameOfLife::randomBoard(double chance){
             }
         }
     }
+    invalidateTiles();
 }
 
 int GameOfLife::step(){
-    // Count of neighbors
-    int count;
-    // Board generated this step
-    bool** nextBoard = new bool*[rows];
-    for(int i = 0; i < rows; i++){
-        nextBoard[i] = new bool[cols];
-        for(int j = 0; j < cols; j++){
-            nextBoard[i][j] = false;
+    // Count of the changed tiles
+    int count = 0;
+
+    // Copy the edges into the halo so every cell sees its wrapped around neighbors
+    refreshHalo();
+
+    // The next board can only differ from the empty board within one cell of the light cone, once it reaches an edge it wraps around and the whole board is stepped
+    if(coneActive){
+        coneTop--;
+        coneBottom++;
+        coneLeft--;
+        coneRight++;
+        coneActive = coneTop >= 0 && coneBottom <= rows && coneLeft >= 0 && coneRight <= cols;
+    }
+
+    // Apply the rule to the active tiles, a row of tiles at a time
+    uint64_t hashDelta = 0;
+    if(pool){
+        // Every band reads the shared halo and writes only its own rows, so the threads only meet at the end of the step
+        pool->parallelFor(tileRows, [this](int tileRow, int worker){
+            bandHashes[tileRow] = 0;
+            bandChanges[tileRow] = stepTileRow(tileRow, scratchRow + 2 * worker * tileSize, bandHashes[tileRow]);
+        });
+
+        // Sum in order so the count matches the serial step
+        for(int ti = 0; ti < tileRows; ti++){
+            count += bandChanges[ti];
+            hashDelta ^= bandHashes[ti];
+        }
+    } else {
+        for(int ti = 0; ti < tileRows; ti++){
+            count += stepTileRow(ti, scratchRow, hashDelta);
         }
     }
 
-    // Apply rules of Conway's Game of Life with wrapping
-    // Upper Left Corner
-    count = 0;
-    count += board[rows - 1][cols - 1]; // Upper Left
-    count += board[rows - 1][0];        // Upper Middle
-    count += board[rows - 1][1];        // Upper Right
-    count += board[0][cols - 1];        // Left
-    count += board[0][1];               // Right
-    count += board[1][cols - 1];        // Lower Left
-    count += board[1][0];               // Lower Middle
-    count += board[1][1];               // Lower Right
+    // The hash of the next board is complete if every tile was hashed
+    int back = 1 - front;
+    if(hashing){
+        boardHashes[back] ^= hashDelta;
+        hashValid[back] = hashValid[back] || numActive == tileRows * tileCols;
+    } else {
+        hashValid[back] = false;
+    }
+    statisticsValid[back] = statistics && (statisticsValid[back] || numActive == tileRows * tileCols);
 
-    // Apply rules based on neighbor count
-    if(count == 2 && board[0][0]){
-        nextBoard[0][0] = true;
-    } else if(count == 3){
-        nextBoard[0][0] = true;
+    // Pointer shuffle
+    bool** tempBoard = board;
+    board = nextBoard;
+    nextBoard = tempBoard;
+    bool* tempData = boardData;
+    boardData = nextBoardData;
+    nextBoardData = tempData;
+    front = back;
+
+    // Wake up the tiles that could change in the next step
+    tilesValid = true;
+    activateTiles();
+
+    // Catch up on the tiles that were skipped while the hashes were out of date
+    if(hashing && !hashValid[front]){
+        rehashBoard();
+    }
+    if(statistics && !statisticsValid[front]){
+        recountStatistics();
     }
 
-    
-    // Top Row Middle
-    for(int j = 1; j < cols - 1; j++){
-        count = 0;
-        count += board[rows - 1][j - 1];    // Upper Left
-        count += board[rows - 1][j];        // Upper Middle
-        count += board[rows - 1][j + 1];    // Upper Right
-        count += board[0][j - 1];           // Left
-        count += board[0][j + 1];           // Right
-        count += board[1][j - 1];           // Lower Left
-        count += board[1][j];               // Lower Middle
-        count += board[1][j + 1];           // Lower Right
-
-        // Apply rules based on neighbor count
-        if(count == 2 && board[0][j]){
-            nextBoard[0][j] = true;
-        } else if(count == 3){
-            nextBoard[0][j] = true;
-        }
-    }
-
-    // Upper Right Corner
-    count = 0;
-    count += board[rows - 1][cols - 2]; // Upper Left
-    count += board[rows - 1][cols - 1]; // Upper Middle
-    count += board[rows - 1][0];        // Upper Right
-    count += board[0][cols - 2];        // Left
-    count += board[0][0];               // Right
-    count += board[1][cols - 2];        // Lower Left
-    count += board[1][cols - 1];        // Lower Middle
-    count += board[1][0];               // Lower Right
-
-    // Apply rules based on neighbor count
-    if(count == 2 && board[0][rows - 1]){
-        nextBoard[0][cols - 1] = true;
-    } else if(count == 3){
-        nextBoard[0][cols - 1] = true;
-    }
-
-    // Between first and last row
-    for(int i = 1; i < rows - 1; i++){
-        // Left column
-        count = 0;
-        count += board[i - 1][cols - 1];    // Upper Left
-        count += board[i - 1][0];           // Upper Middle
-        count += board[i - 1][1];           // Upper Right
-        count += board[i][cols - 1];        // Left
-        count += board[i][1];               // Right
-        count += board[i + 1][cols - 1];    // Lower Left
-        count += board[i + 1][0];           // Lower Middle
-        count += board[i + 1][1];           // Lower Right
-
-        // Apply rules based on neighbor count
-        if(count == 2 && board[i][0]){
-            nextBoard[i][0] = true;
-        } else if(count == 3){
-            nextBoard[i][0] = true;
-        }
-
-        // Internals
-        for(int j = 1; j < cols - 1; j++){
-            count = 0;
-            count += board[i - 1][j - 1];   // Upper Left
-            count += board[i - 1][j];       // Upper Middle
-            count += board[i - 1][j + 1];   // Upper Right
-            count += board[i][j - 1];       // Left
-            count += board[i][j + 1];       // Right
-            count += board[i + 1][j - 1];   // Lower Left
-            count += board[i + 1][j];       // Lower Middle
-            count += board[i + 1][j + 1];   // Lower Right
-
-            // Apply rules based on neighbor count
-            if(count == 2 && board[i][j]){
-                nextBoard[i][j] = true;
-            } else if(count == 3){
-                nextBoard[i][j] = true;
-            }
-        }
-
-        // Right Column
-        count = 0;
-        count += board[i - 1][cols - 2];    // Upper Left
-        count += board[i - 1][cols - 1];    // Upper Middle
-        count += board[i - 1][0];           // Upper Right
-        count += board[i][cols - 2];        // Left
-        count += board[i][0];               // Right
-        count += board[i + 1][cols - 2];    // Lower Left
-        count += board[i + 1][cols - 1];    // Lower Middle
-        count += board[i + 1][0];           // Lower Right
-
-        // Apply rules based on neighbor count
-        if(count == 2 && board[i][cols - 1]){
-            nextBoard[i][cols - 1] = true;
-        } else if(count == 3){
-            nextBoard[i][cols - 1] = true;
-        }
-    }
-
-    // Lower Left Corner
-    count = 0;
-    count += board[rows - 2][cols - 1]; // Upper Left
-    count += board[rows - 2][0];        // Upper Middle
-    count += board[rows - 2][1];        // Upper Right
-    count += board[rows - 1][cols - 1]; // Left
-    count += board[rows - 1][1];        // Right
-    count += board[0][cols - 1];        // Lower Left
-    count += board[0][0];               // Lower Middle
-    count += board[0][1];               // Lower Right
-
-    // Apply rules based on neighbor count
-    if(count == 2 && board[rows - 1][0]){
-        nextBoard[rows - 1][0] = true;
-    } else if(count == 3){
-        nextBoard[rows - 1][0] = true;
-    }
-
-    // Bottom Row Middle
-    for(int j = 1; j < cols - 1; j++){
-        count = 0;
-        count += board[rows - 2][j - 1];    // Upper Left
-        count += board[rows - 2][j];        // Upper Middle
-        count += board[rows - 2][j + 1];    // Upper Right
-        count += board[rows - 1][j - 1];    // Left
-        count += board[rows - 1][j + 1];    // Right
-        count += board[0][j - 1];           // Lower Left
-        count += board[0][j];               // Lower Middle
-        count += board[0][j + 1];           // Lower Right
-
-        // Apply rules based on neighbor count
-        if(count == 2 && board[rows - 1][j]){
-            nextBoard[rows - 1][j] = true;
-        } else if(count == 3){
-            nextBoard[rows - 1][j] = true;
-        }
-    }
-
-    // Lower Right Corner
-    count = 0;
-    count += board[rows - 2][cols - 2]; // Upper Left
-    count += board[rows - 2][cols - 1]; // Upper Middle
-    count += board[rows - 2][0];        // Upper Right
-    count += board[rows - 1][cols - 2]; // Left
-    count += board[rows - 1][0];        // Right
-    count += board[0][cols - 2];        // Lower Left
-    count += board[0][cols - 1];        // Lower Middle
-    count += board[0][0];               // Lower Right
-
-    // Apply rules based on neighbor count
-    if(count == 2 && board[rows - 1][cols - 1]){
-        nextBoard[rows - 1][cols - 1] = true;
-    } else if(count == 3){
-        nextBoard[rows - 1][cols - 1] = true;
-    }
-
-    // Count the number of changes
-    count = 0;
-    for(int i = 0; i < rows; i++){
-        for(int j = 0; j < cols; j++){
-            count += board[i][j] != nextBoard[i][j];
+    return count;
+}
+
+long long GameOfLife::stepMany(int steps){
+    // Count of the changed tiles
+    long long count = 0;
+
+    // Size of the part of a block that is written back, the rest is overlap with the neighboring blocks
+    int core = GAME_OF_LIFE_TEMPORAL_BLOCK - 2 * GAME_OF_LIFE_TEMPORAL_DEPTH;
+    int blockRows = (rows + core - 1) / core;
+    int blockCols = (cols + core - 1) / core;
+    int blockStride = ((GAME_OF_LIFE_TEMPORAL_BLOCK + GAME_OF_LIFE_ALIGNMENT - 1) / GAME_OF_LIFE_ALIGNMENT) * GAME_OF_LIFE_ALIGNMENT;
+    int blockBytes = GAME_OF_LIFE_TEMPORAL_BLOCK * blockStride;
+    int numThreads = getThreads();
+    bool* scratch = (bool*) aligned_alloc(GAME_OF_LIFE_ALIGNMENT, 2 * numThreads * blockBytes);
+
+    while(steps > 0){
+        int generations = min(steps, GAME_OF_LIFE_TEMPORAL_DEPTH);
+
+        // Every block reads the board and writes only its own core into the next board
+        refreshHalo();
+        if(pool){
+            long long* blockChanges = new long long[blockRows * blockCols];
+            pool->parallelFor(blockRows * blockCols, [&](int block, int worker){
+                bool* scratchA = scratch + 2 * worker * blockBytes;
+                blockChanges[block] = stepBlock((block / blockCols) * core, (block % blockCols) * core, generations, scratchA, scratchA + blockBytes);
+            });
+            for(int i = 0; i < blockRows * blockCols; i++){
+                count += blockChanges[i];
+            }
+            delete[](blockChanges);
+        } else {
+            for(int block = 0; block < blockRows * blockCols; block++){
+                count += stepBlock((block / blockCols) * core, (block % blockCols) * core, generations, scratch, scratch + blockBytes);
+            }
         }
+
+        // Pointer shuffle
+        bool** tempBoard = board;
+        board = nextBoard;
+        nextBoard = tempBoard;
+        bool* tempData = boardData;
+        boardData = nextBoardData;
+        nextBoardData = tempData;
+        front = 1 - front;
+
+        steps -= generations;
     }
+    free(scratch);
 
-    // Pointer shuffle
-    deleteBoard();
-    board = nextBoard;
+    // The back buffer no longer holds the previous step
+    invalidateTiles();
 
     return count;
 }
@@ -324,6 +353,130 @@ bool** GameOfLife::getBoard(){
     return board;
 }
 
+void GameOfLife::invalidateTiles(){
+    tilesValid = false;
+    for(int i = 0; i < tileRows * tileCols; i++){
+        tileActive[i] = true;
+        tileDirty[i] = true;
+    }
+    numActive = tileRows * tileCols;
+    coneActive = false;
+
+    // The board may have been changed in any way
+    hashValid[0] = false;
+    hashValid[1] = false;
+    statisticsValid[0] = false;
+    statisticsValid[1] = false;
+}
+
+uint64_t GameOfLife::getHash(){
+    if(!hashValid[front]){
+        rehashBoard();
+    }
+    return boardHashes[front];
+}
+
+GoLStatistics GameOfLife::getStatistics(){
+    if(!statisticsValid[front]){
+        recountStatistics();
+    }
+
+    // Combine the tiles
+    GoLStatistics total;
+    GoLStatistics* stats = tileStatistics + front * tileRows * tileCols;
+    for(int i = 0; i < tileRows * tileCols; i++){
+        total.population += stats[i].population;
+        total.rowSum += stats[i].rowSum;
+        total.colSum += stats[i].colSum;
+        total.minRow = min(total.minRow, stats[i].minRow);
+        total.maxRow = max(total.maxRow, stats[i].maxRow);
+        total.minCol = min(total.minCol, stats[i].minCol);
+        total.maxCol = max(total.maxCol, stats[i].maxCol);
+    }
+    return total;
+}
+
+//---------- ACCESSORS ----------
+int GameOfLife::getTileSize() const{
+    return tileSize;
+}
+
+int GameOfLife::getThreads() const{
+    return pool ? pool->getNumThreads() : 1;
+}
+
+string GameOfLife::getRule() const{
+    return lifeRuleString(rule->birth, rule->survive);
+}
+
+GoLKernel GameOfLife::getKernel() const{
+    return kernel;
+}
+
+bool GameOfLife::sameSettings(const GameOfLife& other) const{
+    return rows == other.rows && cols == other.cols && rule == other.rule && kernel == other.kernel && tileSize == other.tileSize && hashing == other.hashing && statistics == other.statistics;
+}
+
+int GameOfLife::getActiveTiles() const{
+    return numActive;
+}
+
+//---------- MUTATORS ----------
+void GameOfLife::setTileSize(int tileSize){
+    deleteTiles();
+    this->tileSize = max(tileSize, 1);
+    allocTiles();
+}
+
+bool GameOfLife::setRule(const string& rule){
+    const LifeRuleEntry* entry = findLifeRule(rule);
+    if(!entry){
+        return false;
+    }
+    this->rule = entry;
+    if(kernel == GoLKernel::LookupTable){
+        blockTable = getLifeBlockTable(entry);
+    }
+
+    // The tiles that went to sleep under the old rule may wake up under the new one
+    invalidateTiles();
+    return true;
+}
+
+void GameOfLife::setKernel(GoLKernel kernel){
+    this->kernel = kernel;
+    blockTable = kernel == GoLKernel::LookupTable ? getLifeBlockTable(rule) : nullptr;
+}
+
+void GameOfLife::setHashing(bool hashing){
+    this->hashing = hashing;
+    if(!hashing){
+        hashValid[0] = false;
+        hashValid[1] = false;
+    }
+}
+
+void GameOfLife::setStatistics(bool statistics){
+    this->statistics = statistics;
+    if(!statistics){
+        statisticsValid[0] = false;
+        statisticsValid[1] = false;
+    }
+}
+
+void GameOfLife::setThreads(int numThreads){
+    // The scratch memory depends on the number of threads
+    deleteTiles();
+    if(pool){
+        delete(pool);
+        pool = nullptr;
+    }
+    if(numThreads != 1){
+        pool = new ThreadPool(numThreads);
+    }
+    allocTiles();
+}
+
 //---------- DEBUGGING UTILITIES ----------
 void diffPrint(ostream& os, const GameOfLife& obj1, const bool* expectedBoard){
     int index = 0;
@@ -354,49 +507,368 @@ ostream& operator<<(ostream& os, const GameOfLife& obj){
     return os;
 }
 
-//---------- PRIVATE UTILITIES ----------
+//---------- PROTECTED UTILITIES ----------
+void GameOfLife::allocBoard(){
+    // Pad the rows, including the halo, out to the alignment so every row starts on its own cache line
+    stride = ((cols + 2 + GAME_OF_LIFE_ALIGNMENT - 1) / GAME_OF_LIFE_ALIGNMENT) * GAME_OF_LIFE_ALIGNMENT;
+    boardData = (bool*) aligned_alloc(GAME_OF_LIFE_ALIGNMENT, (rows + 2) * stride);
+    nextBoardData = (bool*) aligned_alloc(GAME_OF_LIFE_ALIGNMENT, (rows + 2) * stride);
+    memset(nextBoardData, 0, (rows + 2) * stride);
+
+    // Row pointers start at the halo row and skip the halo column
+    board = new bool*[rows + 2] + 1;
+    nextBoard = new bool*[rows + 2] + 1;
+    for(int i = -1; i <= rows; i++){
+        board[i] = boardData + (i + 1) * stride + 1;
+        nextBoard[i] = nextBoardData + (i + 1) * stride + 1;
+    }
+
+    allocTiles();
+}
+
 void GameOfLife::resetBoard(){
-    // Check if board has been initialized
-    if(!board){
-        // Allocate memory if needed
-        board = new bool*[rows];
-        for(int i = 0; i < rows; i++){
-            board[i] = new bool[cols];
-            for(int j = 0; j < cols; j++){
-                board[i][j] = false;
+    // Both buffers are cleared so a light cone can start from an empty back buffer
+    memset(boardData, 0, (rows + 2) * stride);
+    memset(nextBoardData, 0, (rows + 2) * stride);
+    invalidateTiles();
+}
+
+void GameOfLife::deleteBoard(){
+    // Check for nullptr and clean up the memory
+    if(board){
+        delete[](board - 1);
+        delete[](nextBoard - 1);
+        free(boardData);
+        free(nextBoardData);
+        board = nullptr;
+        nextBoard = nullptr;
+        boardData = nullptr;
+        nextBoardData = nullptr;
+    }
+    deleteTiles();
+}
+
+void GameOfLife::refreshHalo(){
+    // Left and right columns
+    for(int i = 0; i < rows; i++){
+        board[i][-1] = board[i][cols - 1];
+        board[i][cols] = board[i][0];
+    }
+
+    // Top and bottom rows, including the corners
+    memcpy(board[-1] - 1, board[rows - 1] - 1, cols + 2);
+    memcpy(board[rows] - 1, board[0] - 1, cols + 2);
+}
+
+void GameOfLife::allocTiles(){
+    tileRows = (rows + tileSize - 1) / tileSize;
+    tileCols = (cols + tileSize - 1) / tileSize;
+    tileActive = new bool[tileRows * tileCols];
+    tileDirty = new bool[tileRows * tileCols];
+    tileChanges = new int[tileRows * tileCols];
+    scratchRow = new bool[2 * tileSize * getThreads()];
+    bandChanges = new int[tileRows];
+    tileHashes = new uint64_t[2 * tileRows * tileCols];
+    bandHashes = new uint64_t[tileRows];
+    tileStatistics = new GoLStatistics[2 * tileRows * tileCols];
+    for(int i = 0; i < tileRows * tileCols; i++){
+        tileChanges[i] = 0;
+        tileHashes[i] = 0;
+        tileHashes[tileRows * tileCols + i] = 0;
+    }
+    boardHashes[0] = 0;
+    boardHashes[1] = 0;
+    invalidateTiles();
+}
+
+void GameOfLife::deleteTiles(){
+    // Check for nullptr and clean up the memory
+    if(tileActive){
+        delete[](tileActive);
+        delete[](tileDirty);
+        delete[](tileChanges);
+        delete[](scratchRow);
+        delete[](bandChanges);
+        delete[](tileHashes);
+        delete[](bandHashes);
+        delete[](tileStatistics);
+        tileActive = nullptr;
+        tileDirty = nullptr;
+        tileChanges = nullptr;
+        scratchRow = nullptr;
+        bandChanges = nullptr;
+        tileHashes = nullptr;
+        bandHashes = nullptr;
+        tileStatistics = nullptr;
+    }
+}
+
+void GameOfLife::activateTiles(){
+    numActive = 0;
+    // A tile can only change if something within one cell of it changed, which is always inside the tile or one of its neighbors
+    for(int ti = 0; ti < tileRows; ti++){
+        for(int tj = 0; tj < tileCols; tj++){
+            bool active = false;
+            for(int di = -1; di <= 1 && !active; di++){
+                for(int dj = -1; dj <= 1 && !active; dj++){
+                    // Neighbors wrap around the board like the cells do
+                    int ni = (ti + di + tileRows) % tileRows;
+                    int nj = (tj + dj + tileCols) % tileCols;
+                    active = tileDirty[ni * tileCols + nj];
+                }
             }
+            tileActive[ti * tileCols + tj] = active;
+            numActive += active;
         }
-    } else {
-        // Otherwise set all to zero
-        for(int i = 0; i < rows; i++){
-            for(int j = 0; j < cols; j++){
-                board[i][j] = false;
+    }
+}
+
+int GameOfLife::stepTileRow(int tileRow, bool* scratch, uint64_t& hashDelta){
+    // Count of the changed tiles
+    int count = 0;
+    int rowStart = tileRow * tileSize;
+    int rowEnd = min(rowStart + tileSize, rows);
+    for(int tj = 0; tj < tileCols; tj++){
+        int tile = tileRow * tileCols + tj;
+
+        // A sleeping tile flips back to the state two steps ago, which the back buffer already holds, so it changes as much as last time
+        if(!tileActive[tile]){
+            count += tileChanges[tile];
+            continue;
+        }
+
+        int colStart = tj * tileSize;
+        int width = min(colStart + tileSize, cols) - colStart;
+        int changes = 0;
+        bool dirty = !tilesValid;
+
+        // Only the part of the tile inside the light cone can change, the rest stays empty in both buffers
+        int computeRowStart = rowStart;
+        int computeRowEnd = rowEnd;
+        int computeColStart = colStart;
+        int computeWidth = width;
+        if(coneActive){
+            computeRowStart = max(rowStart, coneTop);
+            computeRowEnd = min(rowEnd, coneBottom);
+            computeColStart = max(colStart, coneLeft);
+            computeWidth = min(colStart + width, coneRight) - computeColStart;
+            if(computeWidth <= 0){
+                computeRowEnd = computeRowStart;
+            }
+        }
+
+        // Rows are done in pairs by the lookup table kernel and one at a time by the row kernel
+        int rowsAtOnce = kernel == GoLKernel::LookupTable ? 2 : 1;
+        for(int i = computeRowStart; i < computeRowEnd; i += rowsAtOnce){
+            int numRows = min(rowsAtOnce, computeRowEnd - i);
+
+            // Keep the state from two steps ago to check if the tile can go to sleep
+            if(!dirty){
+                for(int k = 0; k < numRows; k++){
+                    memcpy(scratch + k * tileSize, nextBoard[i + k] + computeColStart, computeWidth);
+                }
+            }
+            if(numRows == 2){
+                changes += lifeBlockRows(board[i - 1] + computeColStart, board[i] + computeColStart, board[i + 1] + computeColStart, board[i + 2] + computeColStart, nextBoard[i] + computeColStart, nextBoard[i + 1] + computeColStart, computeWidth, blockTable);
+            } else {
+                changes += rule->row(board[i - 1] + computeColStart, board[i] + computeColStart, board[i + 1] + computeColStart, nextBoard[i] + computeColStart, computeWidth);
             }
+            for(int k = 0; k < numRows && !dirty; k++){
+                dirty = memcmp(scratch + k * tileSize, nextBoard[i + k] + computeColStart, computeWidth) != 0;
+            }
+        }
+        tileChanges[tile] = changes;
+        tileDirty[tile] = dirty;
+        count += changes;
+
+        // A tile that matches the state two steps ago still has the hash from back then, unless that one is out of date
+        int back = 1 - front;
+        if(hashing && (dirty || !hashValid[back])){
+            uint64_t hash = hashTile(nextBoard, rowStart, rowEnd, colStart, width, cols);
+            uint64_t& tileHash = tileHashes[back * tileRows * tileCols + tile];
+            hashDelta ^= tileHash ^ hash;
+            tileHash = hash;
+        }
+        if(statistics && (dirty || !statisticsValid[back])){
+            tileStatistics[back * tileRows * tileCols + tile] = countTile(nextBoard, rowStart, rowEnd, colStart, width);
         }
     }
+    return count;
 }
 
-void GameOfLife::deleteBoard(){
-    // Check for nullptr and clean up the memory
-    if(board){
-        for(int i = 0; i < rows; i++){
-            delete[](board[i]);
-            board[i] = nullptr;
+void GameOfLife::startLightCone(int top, int bottom, int left, int right){
+    // Both buffers are empty outside of the region so the tiles there can sleep from the very first step
+    // The back buffer is not the generation before the organism though, so the tiles of the region can only go to sleep once a step has filled it
+    tilesValid = false;
+    for(int ti = 0; ti < tileRows; ti++){
+        for(int tj = 0; tj < tileCols; tj++){
+            int tile = ti * tileCols + tj;
+            tileChanges[tile] = 0;
+            tileDirty[tile] = ti * tileSize < bottom && (ti + 1) * tileSize > top && tj * tileSize < right && (tj + 1) * tileSize > left;
         }
-        delete[](board);
-        board = nullptr;
     }
+    activateTiles();
+
+    // Empty tiles hash to 0 and have empty statistics, only the tiles of the region need to be looked at
+    int back = 1 - front;
+    boardHashes[front] = 0;
+    boardHashes[back] = 0;
+    for(int ti = 0; ti < tileRows; ti++){
+        int rowStart = ti * tileSize;
+        int rowEnd = min(rowStart + tileSize, rows);
+        for(int tj = 0; tj < tileCols; tj++){
+            int tile = ti * tileCols + tj;
+            int colStart = tj * tileSize;
+            int width = min(colStart + tileSize, cols) - colStart;
+            tileHashes[front * tileRows * tileCols + tile] = 0;
+            tileHashes[back * tileRows * tileCols + tile] = 0;
+            tileStatistics[front * tileRows * tileCols + tile] = GoLStatistics();
+            tileStatistics[back * tileRows * tileCols + tile] = GoLStatistics();
+            if(tileDirty[tile]){
+                if(hashing){
+                    tileHashes[front * tileRows * tileCols + tile] = hashTile(board, rowStart, rowEnd, colStart, width, cols);
+                    boardHashes[front] ^= tileHashes[front * tileRows * tileCols + tile];
+                }
+                if(statistics){
+                    tileStatistics[front * tileRows * tileCols + tile] = countTile(board, rowStart, rowEnd, colStart, width);
+                }
+            }
+        }
+    }
+    hashValid[front] = hashing;
+    hashValid[back] = hashing;
+    statisticsValid[front] = statistics;
+    statisticsValid[back] = statistics;
+
+    // Cells can only come alive within the region grown by one cell every step
+    coneActive = true;
+    coneTop = top;
+    coneBottom = bottom;
+    coneLeft = left;
+    coneRight = right;
+}
+
+void GameOfLife::rehashBoard(){
+    uint64_t* hashes = tileHashes + front * tileRows * tileCols;
+    boardHashes[front] = 0;
+    for(int ti = 0; ti < tileRows; ti++){
+        int rowStart = ti * tileSize;
+        int rowEnd = min(rowStart + tileSize, rows);
+        for(int tj = 0; tj < tileCols; tj++){
+            int colStart = tj * tileSize;
+            int width = min(colStart + tileSize, cols) - colStart;
+            uint64_t hash = hashTile(board, rowStart, rowEnd, colStart, width, cols);
+            hashes[ti * tileCols + tj] = hash;
+            boardHashes[front] ^= hash;
+        }
+    }
+    hashValid[front] = true;
+}
+
+void GameOfLife::recountStatistics(){
+    GoLStatistics* stats = tileStatistics + front * tileRows * tileCols;
+    for(int ti = 0; ti < tileRows; ti++){
+        int rowStart = ti * tileSize;
+        int rowEnd = min(rowStart + tileSize, rows);
+        for(int tj = 0; tj < tileCols; tj++){
+            int colStart = tj * tileSize;
+            int width = min(colStart + tileSize, cols) - colStart;
+            stats[ti * tileCols + tj] = countTile(board, rowStart, rowEnd, colStart, width);
+        }
+    }
+    statisticsValid[front] = true;
+}
+
+long long GameOfLife::stepBlock(int rowStart, int colStart, int generations, bool* scratchA, bool* scratchB){
+    // Count of the changed tiles
+    long long count = 0;
+    int depth = generations;
+    int coreRows = min(GAME_OF_LIFE_TEMPORAL_BLOCK - 2 * GAME_OF_LIFE_TEMPORAL_DEPTH, rows - rowStart);
+    int coreCols = min(GAME_OF_LIFE_TEMPORAL_BLOCK - 2 * GAME_OF_LIFE_TEMPORAL_DEPTH, cols - colStart);
+    int blockRows = coreRows + 2 * depth;
+    int blockCols = coreCols + 2 * depth;
+    int blockStride = ((GAME_OF_LIFE_TEMPORAL_BLOCK + GAME_OF_LIFE_ALIGNMENT - 1) / GAME_OF_LIFE_ALIGNMENT) * GAME_OF_LIFE_ALIGNMENT;
+
+    // Load the core and a border as deep as the number of generations, wrapping around the board
+    for(int i = 0; i < blockRows; i++){
+        bool* source = board[((rowStart - depth + i) % rows + rows) % rows];
+        bool* dest = scratchA + i * blockStride;
+        int col = ((colStart - depth) % cols + cols) % cols;
+        int copied = 0;
+        while(copied < blockCols){
+            int length = min(blockCols - copied, cols - col);
+            memcpy(dest + copied, source + col, length);
+            copied += length;
+            col = 0;
+        }
+    }
+
+    // Every generation the valid part of the block shrinks by one cell on each side, after the last one only the core is left
+    bool* curr = scratchA;
+    bool* next = scratchB;
+    for(int g = 0; g < generations; g++){
+        int first = g + 1;
+        int last = blockCols - g - 1;
+        for(int i = g + 1; i < blockRows - g - 1; i++){
+            const bool* up = curr + (i - 1) * blockStride;
+            const bool* mid = curr + i * blockStride;
+            const bool* down = curr + (i + 1) * blockStride;
+            bool* out = next + i * blockStride;
+            if(i < depth || i >= depth + coreRows){
+                rule->row(up + first, mid + first, down + first, out + first, last - first);
+            } else {
+                // Only the changes inside the core count, the overlap is counted by the block that owns it
+                rule->row(up + first, mid + first, down + first, out + first, depth - first);
+                count += rule->row(up + depth, mid + depth, down + depth, out + depth, coreCols);
+                rule->row(up + depth + coreCols, mid + depth + coreCols, down + depth + coreCols, out + depth + coreCols, last - depth - coreCols);
+            }
+        }
+        bool* temp = curr;
+        curr = next;
+        next = temp;
+    }
+
+    // Write the core back
+    for(int i = 0; i < coreRows; i++){
+        memcpy(nextBoard[rowStart + i] + colStart, curr + (depth + i) * blockStride + depth, coreCols);
+    }
+
+    return count;
 }
 
 //-------------------------------------------------------------------------------------
 //---------- GameOfLifeGA -------------------------------------------------------------
 //-------------------------------------------------------------------------------------
 //---------- CONSTRUCTORS & DESTRUCTOR ----------
-GameOfLifeGA::GameOfLifeGA() : GeneticAlgorithm(), GameOfLife(), fitnessFunc(GoLFitnessFunction::FinalStepTiles), maxSteps(-1), orgRows(-1), orgCols(-1) {}
+GameOfLifeGA::GameOfLifeGA() : GeneticAlgorithm(), GameOfLife(), fitnessFunc(GoLFitnessFunction::FinalStepTiles), maxSteps(-1), orgRows(-1), orgCols(-1), boundary(GoLBoundary::Toroidal), earlyExit(true), batching(true), engine(nullptr), autoCrop(false), packing(false), differential(false), transpositions(nullptr), fitnessCache(nullptr), fitnessPool(nullptr), workersValid(false) {
+    simulation.game = this;
+    setHashing(true);
+    setStatistics(true);
+}
 
-GameOfLifeGA::GameOfLifeGA(int sizePopulation, int sizeMembers, int numActions, char* actions, int crossovers, double mutationRate, int totalGens, int rows, int cols, GoLFitnessFunction fitnessFunc, int maxSteps, int orgRows, int orgCols) : GeneticAlgorithm(sizePopulation, sizeMembers, numActions, actions,crossovers, mutationRate), GameOfLife(rows, cols), fitnessFunc(fitnessFunc), maxSteps(maxSteps), orgRows(orgRows), orgCols(orgCols){}
+GameOfLifeGA::GameOfLifeGA(int sizePopulation, int sizeMembers, int numActions, char* actions, int crossovers, double mutationRate, int totalGens, int rows, int cols, GoLFitnessFunction fitnessFunc, int maxSteps, int orgRows, int orgCols, GoLBoundary boundary) : GeneticAlgorithm(sizePopulation, sizeMembers, numActions, actions,crossovers, mutationRate), GameOfLife(rows, cols), fitnessFunc(fitnessFunc), maxSteps(maxSteps), orgRows(orgRows), orgCols(orgCols), boundary(boundary), earlyExit(true), batching(true), engine(nullptr), autoCrop(false), packing(false), differential(false), transpositions(nullptr), fitnessCache(nullptr), fitnessPool(nullptr), workersValid(false) {
+    simulation.game = this;
+    setHashing(true);
+    setStatistics(true);
+}
+
+GameOfLifeGA::GameOfLifeGA(const GameOfLifeGA & other) : GeneticAlgorithm(other), GameOfLife(other), fitnessFunc(other.fitnessFunc), weights(other.weights), maxSteps(other.maxSteps), orgRows(other.orgRows), orgCols(other.orgCols), boundary(other.boundary), earlyExit(other.earlyExit), batching(other.batching), engine(nullptr), autoCrop(other.autoCrop), packing(other.packing), differential(other.differential), transpositions(other.transpositions), fitnessCache(other.fitnessCache), fitnessPool(nullptr), workersValid(false) {
+    // The trajectories are only a cache, the copy starts without them
+    // Engines can not be copied, start a new one of the same kind
+    if(other.engine){
+        engine = createLifeEngine(other.engine->getBackend(), rows, cols);
+    }
+    simulation.game = this;
+    simulation.sparse = other.simulation.sparse;
+    if(other.simulation.fixedBoard){
+        simulation.fixedBoard = other.simulation.fixedBoard->clone();
+    }
 
-GameOfLifeGA::GameOfLifeGA(const GameOfLifeGA & other) : GeneticAlgorithm(other), GameOfLife(other), fitnessFunc(other.fitnessFunc), maxSteps(other.maxSteps), orgRows(other.orgRows), orgCols(other.orgCols) {}
+    // The workers are made at the first evaluation
+    if(other.fitnessPool){
+        fitnessPool = new ThreadPool(other.fitnessPool->getNumThreads());
+    }
+}
 
 GameOfLifeGA& GameOfLifeGA::operator=(const GameOfLifeGA & other){
     // Check for self-assignment
@@ -407,50 +879,173 @@ GameOfLifeGA& GameOfLifeGA::operator=(const GameOfLifeGA & other){
 
         // Do other assignments
         fitnessFunc = other.fitnessFunc;
+        weights = other.weights;
         maxSteps = other.maxSteps;
         orgRows = other.orgRows;
         orgCols = other.orgCols;
+        boundary = other.boundary;
+        simulation.sparse = other.simulation.sparse;
+        earlyExit = other.earlyExit;
+        batching = other.batching;
+        autoCrop = other.autoCrop;
+        packing = other.packing;
+        setLifeEngine(other.engine ? createLifeEngine(other.engine->getBackend(), rows, cols) : nullptr);
+        setFixedBoard(other.simulation.fixedBoard ? other.simulation.fixedBoard->clone() : nullptr);
+        differential = other.differential;
+        trajectories.clear();
+        transpositions = other.transpositions;
+        fitnessCache = other.fitnessCache;
+        setFitnessThreads(other.fitnessPool ? other.fitnessPool->getNumThreads() : 1);
     }
     return *this;
 }
 
-GameOfLifeGA::~GameOfLifeGA(){}
+GameOfLifeGA::~GameOfLifeGA(){
+    if(engine){
+        delete(engine);
+    }
+    if(simulation.fixedBoard){
+        delete(simulation.fixedBoard);
+    }
+    if(fitnessPool){
+        delete(fitnessPool);
+    }
+    clearWorkers();
+}
 
 //---------- GENETIC ALGORITHM FUNCTIONS ----------
 double GameOfLifeGA::fitness(int member){
-    if(fitnessFunc == GoLFitnessFunction::FinalStepTiles){
-        return fitnessMostTiles(member);
-    } else if(fitnessFunc == GoLFitnessFunction::AverageChangeTiles){
-        return fitnessAverageChangeTiles(member);
-    } else if(fitnessFunc == GoLFitnessFunction::CenterOfMassMotion){
-        return fitnessCenterOfMassMotion(member);
+    return workerFitness(member, 0);
+}
+
+double GameOfLifeGA::workerFitness(int member, int worker){
+    GoLSimulation& sim = workerSimulation(worker);
+    if(!fitnessCache){
+        return fitnessOf(sim, member);
+    }
+    uint64_t key = cacheKey(member);
+    double value;
+    if(!fitnessCache->lookup(key, value)){
+        value = fitnessOf(sim, member);
+        fitnessCache->store(key, value);
+    }
+    return value;
+}
+
+void GameOfLifeGA::runFitnessWorkers(const function<void(int)>& task){
+    // The engine is a single simulation so only the calling thread can use it
+    if(!fitnessPool || engine){
+        task(0);
+        return;
+    }
+    prepareWorkers();
+    fitnessPool->parallelFor(fitnessPool->getNumThreads(), [&task](int, int worker){
+        task(worker);
+    });
+}
+
+void GameOfLifeGA::evalFitness(){
+    // The batch engine only runs Conway's rule on the torus and does not look for cycles
+    bool conway = rule == findLifeRule(ConwayRule::birth, ConwayRule::survive);
+    bool weighted = fitnessFunc == GoLFitnessFunction::Weighted;
+    bool batched = batching && !engine && !transpositions && boundary == GoLBoundary::Toroidal && conway && fitnessFunc != GoLFitnessFunction::Lifespan && !weighted;
+    bool packed = packing && !engine && boundary == GoLBoundary::Unbounded && !weighted;
+    bool differentiated = differential && !engine && boundary == GoLBoundary::Toroidal && conway && cols <= BIT_GAME_OF_LIFE_WORD_BITS;
+    // The engine is a single simulation so only the calling thread can use it
+    bool parallel = fitnessPool && !engine;
+    if(parallel){
+        prepareWorkers();
+    }
+
+    if(differentiated){
+        fitnessDifferential();
+    } else if(packed){
+        fitnessPacked();
     } else {
-        std::cerr << "Error: invalid fitness function.\n";
-        return 0.0;
+        // Members whose genome was already seen, in the cache or earlier in the population, are not simulated again
+        vector<uint64_t> keys;
+        vector<int> original;
+        vector<int> pending = uncachedMembers(keys, original);
+        int numPending = (int) pending.size();
+
+        if(batched){
+            // Simulate the population 64 members at a time, every worker on batches of its own
+            int numBatches = (numPending + BATCH_GAME_OF_LIFE_LANES - 1) / BATCH_GAME_OF_LIFE_LANES;
+            auto simulateBatch = [this, &pending, numPending](int index, int worker){
+                GoLSimulation& sim = workerSimulation(worker);
+                const int* members = pending.data() + index * BATCH_GAME_OF_LIFE_LANES;
+                int lanes = min(BATCH_GAME_OF_LIFE_LANES, numPending - index * BATCH_GAME_OF_LIFE_LANES);
+                BatchGameOfLife batch = BatchGameOfLife(rows, cols);
+                for(int lane = 0; lane < lanes; lane++){
+                    int placedRows;
+                    int placedCols;
+                    char* organism = placedMember(sim, members[lane], placedRows, placedCols);
+                    batch.addOrganism(lane, placedRows, placedCols, organism);
+                }
+                fitnessBatch(batch, members, lanes);
+            };
+            if(parallel){
+                fitnessPool->parallelFor(numBatches, simulateBatch);
+            } else {
+                for(int index = 0; index < numBatches; index++){
+                    simulateBatch(index, 0);
+                }
+            }
+        } else if(parallel){
+            // Every worker simulates one member at a time on its own boards
+            fitnessPool->parallelFor(numPending, [this, &pending](int index, int worker){
+                fitnessVals[pending[index]] = fitnessOf(workerSimulation(worker), pending[index]);
+            });
+        } else {
+            for(int index = 0; index < numPending; index++){
+                fitnessVals[pending[index]] = fitnessOf(simulation, pending[index]);
+            }
+        }
+        cacheMembers(pending, keys, original);
+    }
+
+    // Track the total
+    totalFitness = 0.0;
+    for(int i = 0; i < sizePopulation; i++){
+        totalFitness += fitnessVals[i];
     }
 }
 
 //---------- UTILITIES ----------
 void GameOfLifeGA::animateMember(int member, int steps){
-    // Reset the board
-    resetBoard();
-
-    // Add the organism
-    addOrganism(orgRows, orgCols, population[member]);
+    // Reset the board and add the organism
+    if(engine){
+        int placedRows;
+        int placedCols;
+        char* organism = placedMember(simulation, member, placedRows, placedCols);
+        engine->reset(placedRows, placedCols, organism);
+    } else {
+        simReset(simulation, member);
+    }
 
-    // Generate the frames
+    // Generate the frames of the rows x cols window
     bool*** frameData = new bool**[steps + 1];
-    frameData[0] = new bool*[rows];
-    for(int i = 0; i < rows; i++){
-        frameData[0][i] = new bool[cols];
-        for(int j = 0; j < cols; j++){
-            frameData[0][i][j] = board[i][j];
+    for(int k = 0; k <= steps; k++){
+        if(k > 0){
+            if(engine){
+                engine->advance(1);
+            } else {
+                simStep(simulation);
+            }
+        }
+        frameData[k] = new bool*[rows];
+        for(int i = 0; i < rows; i++){
+            frameData[k][i] = new bool[cols];
+        }
+        if(engine){
+            engine->getBoardSafe(frameData[k]);
+        } else if(simulation.fixedActive){
+            simulation.fixedBoard->getBoardSafe(frameData[k]);
+        } else if(boundary == GoLBoundary::Unbounded){
+            simulation.sparse.getWindow(0, 0, rows, cols, frameData[k]);
+        } else {
+            getBoardSafe(frameData[k]);
         }
-    }
-
-    for(int k = 0; k < steps; k++){
-        step();
-        getBoardSafe(frameData[k + 1]); 
     }
 
     // Animate
@@ -461,108 +1056,963 @@ void GameOfLifeGA::animateMember(int member, int steps){
     animation.animateBoolGrid(frameData, steps + 1, 5, false, "");
 }
 
-//---------- PRIVATE UTILITIES ----------
-double GameOfLifeGA::fitnessMostTiles(int member){
-    // Reset the board
-    resetBoard();
-
-    // Add the organism in
-    addOrganism(orgRows, orgCols, population[member]);
-
-    // Step the game forward
-    for(int i = 0; i < maxSteps; i++){
-        step();
-    }
+GoLMetrics GameOfLifeGA::evalMetrics(int member){
+    return metricsOf(simulation, member);
+}
 
-    // Count all the tiles that are on
-    double fitness = 0.0;
-    for(int i = 0; i < rows; i++){
-        for(int j = 0; j < cols; j++){
-            if(board[i][j]){
-                fitness += 1.0;
-            }
+vector<GoLMetrics> GameOfLifeGA::evalMetrics(){
+    vector<GoLMetrics> metrics(sizePopulation);
+    if(fitnessPool){
+        // Every worker measures one member at a time on its own boards
+        prepareWorkers();
+        fitnessPool->parallelFor(sizePopulation, [this, &metrics](int member, int worker){
+            metrics[member] = metricsOf(workerSimulation(worker), member);
+        });
+    } else {
+        for(int member = 0; member < sizePopulation; member++){
+            metrics[member] = metricsOf(simulation, member);
         }
     }
-
-    return fitness;
+    return metrics;
 }
 
-double GameOfLifeGA::fitnessAverageChangeTiles(int member){
-    // Reset the board
-    resetBoard();
-
-    // Add the organism in
-    addOrganism(orgRows, orgCols, population[member]);
-
+double GameOfLifeGA::projectMetrics(const GoLMetrics& metrics, GoLFitnessFunction fitnessFunc) const{
+    if(fitnessFunc == GoLFitnessFunction::FinalStepTiles){
+        return metrics.finalPopulation;
+    } else if(fitnessFunc == GoLFitnessFunction::AverageChangeTiles){
+        return metrics.meanChange;
+    } else if(fitnessFunc == GoLFitnessFunction::CenterOfMassMotion){
+        return metrics.centerOfMassMotion;
+    } else if(fitnessFunc == GoLFitnessFunction::Lifespan){
+        return metrics.lifespan;
+    } else if(fitnessFunc == GoLFitnessFunction::Weighted){
+        return weights.finalPopulation * metrics.finalPopulation + weights.meanChange * metrics.meanChange + weights.centerOfMassMotion * metrics.centerOfMassMotion + weights.peakPopulation * metrics.peakPopulation + weights.lifespan * metrics.lifespan;
+    } else {
+        std::cerr << "Error: invalid fitness function.\n";
+        return 0.0;
+    }
+}
+
+//---------- MUTATORS ----------
+void GameOfLifeGA::setFitnessFunction(GoLFitnessFunction fitnessFunc){
+    // The trajectories only stop at their cycle where the fitness function needs it
+    this->fitnessFunc = fitnessFunc;
+    trajectories.clear();
+}
+
+void GameOfLifeGA::setEarlyExit(bool earlyExit){
+    this->earlyExit = earlyExit;
+
+    // The trajectories stop at different places now
+    trajectories.clear();
+}
+
+void GameOfLifeGA::setBatching(bool batching){
+    this->batching = batching;
+}
+
+void GameOfLifeGA::setPacking(bool packing){
+    this->packing = packing;
+}
+
+void GameOfLifeGA::setDifferential(bool differential){
+    this->differential = differential;
+    trajectories.clear();
+}
+
+void GameOfLifeGA::setTranspositionTable(TranspositionTable* transpositions){
+    this->transpositions = transpositions;
+}
+
+void GameOfLifeGA::setAutoCrop(bool autoCrop){
+    this->autoCrop = autoCrop;
+}
+
+void GameOfLifeGA::setLifeEngine(LifeEngine* engine){
+    if(this->engine){
+        delete(this->engine);
+    }
+    this->engine = engine;
+}
+
+void GameOfLifeGA::setFixedBoard(FixedLife* fixedBoard){
+    if(simulation.fixedBoard){
+        delete(simulation.fixedBoard);
+    }
+    simulation.fixedBoard = fixedBoard;
+    simulation.fixedActive = false;
+    workersValid = false;
+
+    // The board has to match the simulation
+    if(fixedBoard && (fixedBoard->getRows() != rows || fixedBoard->getCols() != cols)){
+        std::cerr << "Error: the fixed size board is " << fixedBoard->getRows() << " x " << fixedBoard->getCols() << ", not " << rows << " x " << cols << ".\n";
+        delete(simulation.fixedBoard);
+        simulation.fixedBoard = nullptr;
+    }
+}
+
+void GameOfLifeGA::setFitnessCache(FitnessCache* fitnessCache){
+    this->fitnessCache = fitnessCache;
+}
+
+void GameOfLifeGA::setFitnessThreads(int numThreads){
+    if(fitnessPool){
+        delete(fitnessPool);
+        fitnessPool = nullptr;
+    }
+    clearWorkers();
+    if(numThreads != 1){
+        fitnessPool = new ThreadPool(numThreads);
+        // The members already use every thread, a board stepping on several more would oversubscribe the cores
+        if(getThreads() != 1){
+            setThreads(1);
+        }
+    }
+}
+
+void GameOfLifeGA::setFitnessWeights(const GoLMetrics& weights){
+    this->weights = weights;
+}
+
+//---------- PRIVATE UTILITIES ----------
+double GameOfLifeGA::fitnessOf(GoLSimulation& sim, int member){
+    if(fitnessFunc == GoLFitnessFunction::FinalStepTiles){
+        return fitnessMostTiles(sim, member);
+    } else if(fitnessFunc == GoLFitnessFunction::AverageChangeTiles){
+        return fitnessAverageChangeTiles(sim, member);
+    } else if(fitnessFunc == GoLFitnessFunction::CenterOfMassMotion){
+        return fitnessCenterOfMassMotion(sim, member);
+    } else if(fitnessFunc == GoLFitnessFunction::Lifespan){
+        return fitnessLifespan(sim, member);
+    } else if(fitnessFunc == GoLFitnessFunction::Weighted){
+        return projectMetrics(metricsOf(sim, member), fitnessFunc);
+    } else {
+        std::cerr << "Error: invalid fitness function.\n";
+        return 0.0;
+    }
+}
+
+GoLSimulation& GameOfLifeGA::workerSimulation(int worker){
+    return worker == 0 ? simulation : *workers[worker - 1];
+}
+
+void GameOfLifeGA::prepareWorkers(){
+    int numWorkers = fitnessPool->getNumThreads() - 1;
+    while((int) workers.size() < numWorkers){
+        workers.push_back(new GoLSimulation());
+    }
+    for(GoLSimulation* worker : workers){
+        // Same rule and settings as the calling thread's board, stepped by the worker alone
+        if(!worker->game || !worker->game->sameSettings(*this)){
+            if(worker->game){
+                delete(worker->game);
+            }
+            worker->game = new GameOfLife(*this);
+            if(worker->game->getThreads() != 1){
+                worker->game->setThreads(1);
+            }
+        }
+        if(!workersValid){
+            if(worker->fixedBoard){
+                delete(worker->fixedBoard);
+            }
+            worker->fixedBoard = simulation.fixedBoard ? simulation.fixedBoard->clone() : nullptr;
+        }
+        worker->fixedActive = false;
+    }
+    workersValid = true;
+}
+
+void GameOfLifeGA::clearWorkers(){
+    for(GoLSimulation* worker : workers){
+        if(worker->game){
+            delete(worker->game);
+        }
+        if(worker->fixedBoard){
+            delete(worker->fixedBoard);
+        }
+        delete(worker);
+    }
+    workers.clear();
+    workersValid = false;
+}
+
+uint64_t GameOfLifeGA::cacheKey(int member){
+    // Life-like rules treat every direction the same, so the fitness can only tell images of the organism apart through the board
+    // Only the center of mass on the torus depends on where the organism is, and the quarter turns need a square board unless the plane is unbounded
+    bool centerOfMass = fitnessFunc == GoLFitnessFunction::CenterOfMassMotion || (fitnessFunc == GoLFitnessFunction::Weighted && weights.centerOfMassMotion != 0.0);
+    bool translations = boundary == GoLBoundary::Unbounded || !centerOfMass;
+    int numSymmetries = !translations ? 1 : (boundary == GoLBoundary::Unbounded || rows == cols ? 8 : 4);
+    uint64_t hash = canonicalOrganismHash(population[member], orgRows, orgCols, translations, numSymmetries);
+
+    // The fitness also depends on the fitness function, the size, edges and rule of the board, the number of steps and where the organism is placed
+    // Every field is mixed in on its own so no two settings can cancel out
+    const uint64_t fields[] = {(uint64_t) fitnessFunc, (uint64_t) boundary, (uint64_t) autoCrop, (uint64_t) (uint32_t) rows, (uint64_t) (uint32_t) cols, (uint64_t) (uint32_t) maxSteps, ((uint64_t) rule->birth << 16) | rule->survive};
+    uint64_t config = 0;
+    for(uint64_t field : fields){
+        config = mixHash(config ^ field);
+    }
+    if(fitnessFunc == GoLFitnessFunction::Weighted){
+        // The weighted fitness also depends on the weights
+        const double values[] = {weights.finalPopulation, weights.meanChange, weights.centerOfMassMotion, weights.peakPopulation, weights.lifespan};
+        for(double value : values){
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            config = mixHash(config ^ bits);
+        }
+    }
+    return hash ^ config;
+}
+
+vector<int> GameOfLifeGA::uncachedMembers(vector<uint64_t>& keys, vector<int>& original){
+    vector<int> pending;
+    if(!fitnessCache){
+        for(int member = 0; member < sizePopulation; member++){
+            pending.push_back(member);
+        }
+        return pending;
+    }
+
+    keys.resize(sizePopulation);
+    original.assign(sizePopulation, -1);
+    unordered_map<uint64_t, int> first;
+    for(int member = 0; member < sizePopulation; member++){
+        keys[member] = cacheKey(member);
+        auto found = first.find(keys[member]);
+        if(found != first.end()){
+            original[member] = found->second;
+        } else if(!fitnessCache->lookup(keys[member], fitnessVals[member])){
+            first[keys[member]] = member;
+            pending.push_back(member);
+        }
+    }
+    return pending;
+}
+
+void GameOfLifeGA::cacheMembers(const vector<int>& pending, const vector<uint64_t>& keys, const vector<int>& original){
+    if(!fitnessCache){
+        return;
+    }
+    for(int member : pending){
+        fitnessCache->store(keys[member], fitnessVals[member]);
+    }
+    for(int member = 0; member < sizePopulation; member++){
+        if(original[member] >= 0){
+            fitnessVals[member] = fitnessVals[original[member]];
+        }
+    }
+}
+
+uint64_t GameOfLifeGA::transpositionKey(const GoLSimulation& sim, uint64_t hash){
+    // The rest of the fitness depends on the fitness function, the size, edges and rule of the board and which simulation made the hash
+    // Every field is mixed in on its own like the fitness cache key
+    const uint64_t fields[] = {(uint64_t) fitnessFunc, (uint64_t) boundary, (uint64_t) sim.fixedActive, (uint64_t) (uint32_t) rows, (uint64_t) (uint32_t) cols, ((uint64_t) rule->birth << 16) | rule->survive};
+    uint64_t config = 0;
+    for(uint64_t field : fields){
+        config = mixHash(config ^ field);
+    }
+    return hash ^ config;
+}
+
+bool GameOfLifeGA::lookupRemaining(GoLSimulation& sim, int generation, vector<uint64_t>& hashes, double& value){
+    if(!transpositions || generation >= maxSteps){
+        return false;
+    }
+    uint64_t hash = transpositionKey(sim, simHash(sim));
+    if(transpositions->lookup(hash, maxSteps - generation, value)){
+        return true;
+    }
+    hashes.push_back(hash);
+    return false;
+}
+
+void GameOfLifeGA::storeRemaining(const vector<uint64_t>& hashes, const vector<double>& steps, double total){
+    // hashes[j] is the board of generation j, whose rest of the fitness is the total less what the steps up to it added
+    double before = 0.0;
+    for(int j = 0; j < (int) hashes.size(); j++){
+        if(!steps.empty() && j > 0){
+            before += steps[j];
+        }
+        transpositions->store(hashes[j], maxSteps - j, total - before);
+    }
+}
+
+void GameOfLifeGA::fitnessBatch(BatchGameOfLife& batch, const int* members, int lanes){
+    // Same steps as the fitness functions of a single member, done for every lane
+    long long changes[BATCH_GAME_OF_LIFE_LANES];
+    GoLStatistics stats[BATCH_GAME_OF_LIFE_LANES];
+    double fitness[BATCH_GAME_OF_LIFE_LANES];
+    double oldXCoM[BATCH_GAME_OF_LIFE_LANES];
+    double oldYCoM[BATCH_GAME_OF_LIFE_LANES];
+    bool centerOfMass = fitnessFunc == GoLFitnessFunction::CenterOfMassMotion;
+    if(centerOfMass){
+        batch.getStatistics(stats);
+    }
+    for(int lane = 0; lane < lanes; lane++){
+        fitness[lane] = 0.0;
+        oldXCoM[lane] = 0.0;
+        oldYCoM[lane] = 0.0;
+        if(centerOfMass && stats[lane].population > 0){
+            oldXCoM[lane] = (stats[lane].colSum + 0.5 * stats[lane].population) / stats[lane].population;
+            oldYCoM[lane] = (stats[lane].rowSum + 0.5 * stats[lane].population) / stats[lane].population;
+        }
+    }
+
     // Step the game forward
-    double fitness = 0.0;
-    for(int i = 0; i < maxSteps; i++){
-        fitness += step();
+    for(int k = 1; k <= maxSteps; k++){
+        uint64_t changed = batch.step(fitnessFunc == GoLFitnessFunction::AverageChangeTiles ? changes : nullptr);
+
+        // Once no board changes the rest of the steps change nothing and do not move
+        if(!changed){
+            break;
+        }
+        if(fitnessFunc == GoLFitnessFunction::AverageChangeTiles){
+            for(int lane = 0; lane < lanes; lane++){
+                fitness[lane] += (double) changes[lane];
+            }
+        } else if(centerOfMass){
+            // A board that died out keeps the last center of mass
+            batch.getStatistics(stats);
+            for(int lane = 0; lane < lanes; lane++){
+                double newXCoM = oldXCoM[lane];
+                double newYCoM = oldYCoM[lane];
+                if(stats[lane].population > 0){
+                    newXCoM = (stats[lane].colSum + 0.5 * stats[lane].population) / stats[lane].population;
+                    newYCoM = (stats[lane].rowSum + 0.5 * stats[lane].population) / stats[lane].population;
+                }
+                double delX = newXCoM - oldXCoM[lane];
+                double delY = newYCoM - oldYCoM[lane];
+                fitness[lane] += sqrt(delX * delX + delY * delY);
+                oldXCoM[lane] = newXCoM;
+                oldYCoM[lane] = newYCoM;
+            }
+        }
+    }
+
+    // Final values
+    if(fitnessFunc == GoLFitnessFunction::FinalStepTiles){
+        batch.getStatistics(stats);
+        for(int lane = 0; lane < lanes; lane++){
+            fitnessVals[members[lane]] = (double) stats[lane].population;
+        }
+    } else {
+        for(int lane = 0; lane < lanes; lane++){
+            fitnessVals[members[lane]] = fitness[lane] / ((double) maxSteps);
+        }
     }
-    return fitness / ((double) maxSteps);
 }
 
-double GameOfLifeGA::fitnessCenterOfMassMotion(int member){
-    // Reset the board
-    resetBoard();
+void GameOfLifeGA::fitnessPacked(){
+    // A cell can only be affected by cells up to one step away per step, so members more than 2 * maxSteps + 1 cells apart never meet
+    // Each member gets a square region of whole chunks with a margin of at least maxSteps + 1 cells around it
+    // Members sit in the same place within their chunks as they do alone, so they do not spill into more chunks
+    int steps = max(0, maxSteps);
+    int margin = steps + 1;
+    int regionChunks = (max(orgRows, orgCols) + 2 * margin + 2 * SPARSE_CHUNK_SIZE - 2) / SPARSE_CHUNK_SIZE;
+    int regionsPerRow = (int) ceil(sqrt((double) sizePopulation));
+    simulation.sparse.clear();
+    simulation.sparse.setRegions(regionChunks, regionsPerRow);
+
+    // Offsets from the region coordinates to where the member sits in the rows x cols window when it is simulated alone
+    vector<long long> rowOffsets(sizePopulation);
+    vector<long long> colOffsets(sizePopulation);
+    for(int member = 0; member < sizePopulation; member++){
+        int placedRows;
+        int placedCols;
+        char* organism = placedMember(simulation, member, placedRows, placedCols);
+        int row = (rows - placedRows) / 2;
+        int col = (cols - placedCols) / 2;
+        int regionRow = margin + ((row - margin) % SPARSE_CHUNK_SIZE + SPARSE_CHUNK_SIZE) % SPARSE_CHUNK_SIZE;
+        int regionCol = margin + ((col - margin) % SPARSE_CHUNK_SIZE + SPARSE_CHUNK_SIZE) % SPARSE_CHUNK_SIZE;
+        simulation.sparse.addOrganism(simulation.sparse.getRegionRow(member) + regionRow, simulation.sparse.getRegionCol(member) + regionCol, placedRows, placedCols, organism);
+        rowOffsets[member] = row - regionRow;
+        colOffsets[member] = col - regionCol;
+    }
 
-    // Add the organism in
-    addOrganism(orgRows, orgCols, population[member]);
+    // Per step values of every member, for working out the rest of the steps once a member repeats
+    vector<SparseRegionStatistics> stats(sizePopulation);
+    vector<long long> changes(sizePopulation);
+    vector<vector<double>> values(sizePopulation);
+    vector<CycleDetector> detectors(sizePopulation);
+    vector<double> oldXCoM(sizePopulation, 0.0);
+    vector<double> oldYCoM(sizePopulation, 0.0);
+    vector<bool> finished(sizePopulation, false);
+    bool detect = earlyExit || fitnessFunc == GoLFitnessFunction::Lifespan;
+    int unfinished = sizePopulation;
+    simulation.sparse.getRegionStatistics(sizePopulation, stats.data());
+    for(int member = 0; member < sizePopulation; member++){
+        const SparseRegionStatistics& memberStats = stats[member];
+        if(memberStats.population > 0){
+            oldXCoM[member] = (memberStats.colSum + colOffsets[member] * memberStats.population + 0.5 * memberStats.population) / memberStats.population;
+            oldYCoM[member] = (memberStats.rowSum + rowOffsets[member] * memberStats.population + 0.5 * memberStats.population) / memberStats.population;
+        }
+        values[member].push_back(fitnessFunc == GoLFitnessFunction::FinalStepTiles ? (double) memberStats.population : 0.0);
+        if(detect){
+            detectors[member].record(memberStats.hash, 0);
+        }
+        fitnessVals[member] = 0.0;
+    }
 
-    // Calculate the center of mass
-    double numerXCoM;
-    double numerYCoM;
-    double denomCoM;
-    for(int i = 0; i < rows; i++){
-        for(int j = 0; j < cols; j++){
-            if(board[i][j]){
-                numerYCoM += (i + 0.5);
-                numerXCoM += (j + 0.5);
-                denomCoM += 1.0;
+    // Step every member forward at once
+    for(int k = 1; k <= steps && unfinished > 0; k++){
+        fill(changes.begin(), changes.end(), 0);
+        simulation.sparse.step(changes.data());
+        simulation.sparse.getRegionStatistics(sizePopulation, stats.data());
+        for(int member = 0; member < sizePopulation; member++){
+            if(finished[member]){
+                continue;
+            }
+
+            // Same values as the fitness functions of a single member
+            const SparseRegionStatistics& memberStats = stats[member];
+            double value = 0.0;
+            if(fitnessFunc == GoLFitnessFunction::FinalStepTiles){
+                value = (double) memberStats.population;
+            } else if(fitnessFunc == GoLFitnessFunction::AverageChangeTiles){
+                value = (double) changes[member];
+            } else if(fitnessFunc == GoLFitnessFunction::CenterOfMassMotion){
+                // A board that died out keeps the last center of mass
+                double newXCoM = oldXCoM[member];
+                double newYCoM = oldYCoM[member];
+                if(memberStats.population > 0){
+                    newXCoM = (memberStats.colSum + colOffsets[member] * memberStats.population + 0.5 * memberStats.population) / memberStats.population;
+                    newYCoM = (memberStats.rowSum + rowOffsets[member] * memberStats.population + 0.5 * memberStats.population) / memberStats.population;
+                }
+                double delX = newXCoM - oldXCoM[member];
+                double delY = newYCoM - oldYCoM[member];
+                value = sqrt(delX * delX + delY * delY);
+                oldXCoM[member] = newXCoM;
+                oldYCoM[member] = newYCoM;
+            }
+            values[member].push_back(value);
+            if(fitnessFunc != GoLFitnessFunction::FinalStepTiles){
+                fitnessVals[member] += value;
+            }
+
+            // Once the member repeats the rest of its steps are known, so its region is cleared to stop simulating it
+            if(detect && detectors[member].record(memberStats.hash, k)){
+                const CycleDetector& detector = detectors[member];
+                if(fitnessFunc == GoLFitnessFunction::FinalStepTiles){
+                    fitnessVals[member] = values[member][detector.equivalentGeneration(steps)];
+                } else if(fitnessFunc == GoLFitnessFunction::Lifespan){
+                    fitnessVals[member] = (double) detector.getCycleStart();
+                } else {
+                    fitnessVals[member] = detector.extrapolateSum(values[member], steps);
+                }
+                finished[member] = true;
+                unfinished--;
+                simulation.sparse.clearRegion(member);
             }
         }
     }
-    double oldXCoM = numerXCoM / denomCoM;
-    double oldYCoM = numerYCoM / denomCoM;
-    double newXCoM = 0.0;
-    double newYCoM = 0.0;
+
+    // Final values
+    for(int member = 0; member < sizePopulation; member++){
+        if(fitnessFunc == GoLFitnessFunction::FinalStepTiles){
+            if(!finished[member]){
+                fitnessVals[member] = values[member].back();
+            }
+        } else if(fitnessFunc == GoLFitnessFunction::Lifespan){
+            if(!finished[member]){
+                fitnessVals[member] = (double) steps;
+            }
+        } else {
+            fitnessVals[member] /= (double) maxSteps;
+        }
+    }
+    simulation.sparse.clear();
+    simulation.sparse.setRegions(0, 0);
+}
+
+void GameOfLifeGA::fitnessDifferential(){
+    int steps = max(0, maxSteps);
+    bool stopAtCycle = earlyExit || fitnessFunc == GoLFitnessFunction::Lifespan || fitnessFunc == GoLFitnessFunction::Weighted;
+    vector<LifeTrajectory> evaluated(sizePopulation, LifeTrajectory(rows, cols));
+    vector<uint64_t> start;
+    for(int member = 0; member < sizePopulation; member++){
+        int placedRows;
+        int placedCols;
+        char* organism = placedMember(simulation, member, placedRows, placedCols);
+        evaluated[member].placeOrganism(placedRows, placedCols, organism, start);
+
+        // Closest starting board of the last population or the members of this one done so far
+        const LifeTrajectory* parent = nullptr;
+        int bestDistance = INT_MAX;
+        for(const LifeTrajectory& candidate : trajectories){
+            int distance = candidate.startDistance(start);
+            if(distance < bestDistance){
+                parent = &candidate;
+                bestDistance = distance;
+            }
+        }
+        for(int other = 0; other < member && bestDistance > 0; other++){
+            int distance = evaluated[other].startDistance(start);
+            if(distance < bestDistance){
+                parent = &evaluated[other];
+                bestDistance = distance;
+            }
+        }
+
+        // A member that is not new needs no simulation, one that is far from every parent falls back to a full simulation after the first step
+        if(bestDistance == 0){
+            evaluated[member] = *parent;
+        } else if(parent){
+            evaluated[member].simulateFrom(*parent, start, steps, stopAtCycle);
+        } else {
+            evaluated[member].simulate(start, steps, stopAtCycle);
+        }
+        fitnessVals[member] = projectMetrics(metricsTrajectory(evaluated[member]), fitnessFunc);
+    }
+    trajectories.swap(evaluated);
+}
+
+GoLMetrics GameOfLifeGA::metricsTrajectory(const LifeTrajectory& trajectory){
+    int steps = max(0, maxSteps);
+    const CycleDetector& detector = trajectory.getDetector();
+    GoLMetrics metrics;
+    metrics.finalPopulation = (double) trajectory.getStatistics(steps).population;
+    metrics.lifespan = detector.foundCycle() ? (double) detector.getCycleStart() : (double) maxSteps;
+
+    // Same per step values as the fitness functions of a single member
+    const LifeStepStatistics& first = trajectory.getStatistics(0);
+    double oldXCoM = 0.0;
+    double oldYCoM = 0.0;
+    if(first.population > 0){
+        oldXCoM = (first.colSum + 0.5 * first.population) / first.population;
+        oldYCoM = (first.rowSum + 0.5 * first.population) / first.population;
+    }
+    double changeSum = 0.0;
+    double motionSum = 0.0;
+    vector<double> changes = {0.0};
+    vector<double> motion = {0.0};
+    metrics.peakPopulation = (double) first.population;
+    for(int k = 1; k < trajectory.getGenerations(); k++){
+        const LifeStepStatistics& stepStats = trajectory.getStatistics(k);
+        changes.push_back((double) stepStats.changes);
+        changeSum += changes.back();
+        metrics.peakPopulation = max(metrics.peakPopulation, (double) stepStats.population);
+
+        // A board that died out keeps the last center of mass
+        double newXCoM = oldXCoM;
+        double newYCoM = oldYCoM;
+        if(stepStats.population > 0){
+            newXCoM = (stepStats.colSum + 0.5 * stepStats.population) / stepStats.population;
+            newYCoM = (stepStats.rowSum + 0.5 * stepStats.population) / stepStats.population;
+        }
+        double delX = newXCoM - oldXCoM;
+        double delY = newYCoM - oldYCoM;
+        motion.push_back(sqrt(delX * delX + delY * delY));
+        motionSum += motion.back();
+        oldXCoM = newXCoM;
+        oldYCoM = newYCoM;
+    }
+
+    // Once the board repeats the rest of the values go around the cycle, and the boards after it have all been seen
+    if(detector.foundCycle()){
+        changeSum = detector.extrapolateSum(changes, steps);
+        motionSum = detector.extrapolateSum(motion, steps);
+    }
+    metrics.meanChange = changeSum / ((double) maxSteps);
+    metrics.centerOfMassMotion = motionSum / ((double) maxSteps);
+    return metrics;
+}
+
+double GameOfLifeGA::fitnessMostTiles(GoLSimulation& sim, int member){
+    // Only the final board matters so the whole run can be handed to the engine
+    if(engine){
+        int placedRows;
+        int placedCols;
+        char* organism = placedMember(sim, member, placedRows, placedCols);
+        engine->reset(placedRows, placedCols, organism);
+        engine->advance(maxSteps);
+        return (double) engine->getPopulation();
+    }
+
+    // Reset the board and add the organism in
+    simReset(sim, member);
+    sim.detector.reset();
+    sim.detector.record(simHash(sim), 0);
+
+    // Boards of the simulation that were not in the transposition table
+    vector<uint64_t> hashes;
+    double fitness;
+    bool found = lookupRemaining(sim, 0, hashes, fitness);
+
+    // Step the game forward
+    for(int k = 1; k <= maxSteps && !found; k++){
+        simStep(sim);
+
+        // Once the board repeats only the position in the cycle at the last step matters
+        if(earlyExit && sim.detector.record(simHash(sim), k)){
+            int remaining = (maxSteps - k) % sim.detector.getPeriod();
+            for(int i = 0; i < remaining; i++){
+                simStep(sim);
+            }
+            break;
+        }
+
+        // A board seen before with as many steps left ends the same way
+        found = lookupRemaining(sim, k, hashes, fitness);
+    }
+
+    // Count all the tiles that are on
+    if(!found){
+        fitness = (double) simPopulation(sim);
+    }
+    storeRemaining(hashes, vector<double>(), fitness);
+    return fitness;
+}
+
+double GameOfLifeGA::fitnessAverageChangeTiles(GoLSimulation& sim, int member){
+    // Reset the board and add the organism in
+    simReset(sim, member);
+    sim.detector.reset();
+    sim.detector.record(simHash(sim), 0);
+
+    // Boards of the simulation that were not in the transposition table
+    vector<uint64_t> hashes;
+    double remaining;
+    if(lookupRemaining(sim, 0, hashes, remaining)){
+        return remaining / ((double) maxSteps);
+    }
+
+    // Step the game forward
+    double fitness = 0.0;
+    vector<double> changes = {0.0};
+    for(int k = 1; k <= maxSteps; k++){
+        changes.push_back(simStep(sim));
+        fitness += changes.back();
+
+        // Once the board repeats the rest of the changes go around the cycle
+        if(earlyExit && sim.detector.record(simHash(sim), k)){
+            fitness = sim.detector.extrapolateSum(changes, maxSteps);
+            break;
+        }
+
+        // A board seen before with as many steps left changes the same from there on
+        if(lookupRemaining(sim, k, hashes, remaining)){
+            fitness += remaining;
+            break;
+        }
+    }
+    storeRemaining(hashes, changes, fitness);
+    return fitness / ((double) maxSteps);
+}
+
+double GameOfLifeGA::fitnessCenterOfMassMotion(GoLSimulation& sim, int member){
+    // Reset the board and add the organism in
+    simReset(sim, member);
+    sim.detector.reset();
+    sim.detector.record(simHash(sim), 0);
+
+    // Boards of the simulation that were not in the transposition table
+    vector<uint64_t> hashes;
+    double remaining;
+    if(lookupRemaining(sim, 0, hashes, remaining)){
+        return remaining / ((double) maxSteps);
+    }
+
+    // Calculate the center of mass
+    double oldXCoM = 0.0;
+    double oldYCoM = 0.0;
+    simCenterOfMass(sim, oldXCoM, oldYCoM);
+    double newXCoM = oldXCoM;
+    double newYCoM = oldYCoM;
     double delX;
     double delY;
 
     // Step the game forward
     double fitness = 0.0;
-    for(int k = 0; k < maxSteps; k++){
+    vector<double> motion = {0.0};
+    for(int k = 1; k <= maxSteps; k++){
         // Perform step
-        step();
+        simStep(sim);
+
+        // Calculate the new center of mass, a board that died out keeps the last one
+        simCenterOfMass(sim, newXCoM, newYCoM);
 
-        // Calculate the new center of mass
-        for(int i = 0; i < rows; i++){
-            for(int j = 0; j < cols; j++){
-                if(board[i][j]){
-                    numerYCoM += (i + 0.5);
-                    numerXCoM += (j + 0.5);
-                    denomCoM += 1.0;
-                }
-            }
-        }
-        newXCoM = numerXCoM / denomCoM;
-        newYCoM = numerYCoM / denomCoM;
-        
         // Calculate the differences
         delX = newXCoM - oldXCoM;
         delY = newYCoM - oldYCoM;
 
         // Update fitness
-        fitness += sqrt(delX * delX + delY * delY);
+        motion.push_back(sqrt(delX * delX + delY * delY));
+        fitness += motion.back();
 
         // Cycle new to old
         oldXCoM = newXCoM;
         oldYCoM = newYCoM;
+
+        // Once the board repeats the rest of the motion goes around the cycle
+        if(earlyExit && sim.detector.record(simHash(sim), k)){
+            fitness = sim.detector.extrapolateSum(motion, maxSteps);
+            break;
+        }
+
+        // A board seen before with as many steps left moves the same from there on, a board that died out moves no further either way
+        if(lookupRemaining(sim, k, hashes, remaining)){
+            fitness += remaining;
+            break;
+        }
     }
+    storeRemaining(hashes, motion, fitness);
     return fitness / ((double) maxSteps);
 }
 
+double GameOfLifeGA::fitnessLifespan(GoLSimulation& sim, int member){
+    // Reset the board and add the organism in
+    simReset(sim, member);
+    sim.detector.reset();
+    sim.detector.record(simHash(sim), 0);
+
+    // Step the game forward until the board repeats, dying out counts as repeating the empty board
+    for(int k = 1; k <= maxSteps; k++){
+        simStep(sim);
+        if(sim.detector.record(simHash(sim), k)){
+            return (double) sim.detector.getCycleStart();
+        }
+    }
+    return (double) maxSteps;
+}
+
+GoLMetrics GameOfLifeGA::metricsOf(GoLSimulation& sim, int member){
+    // Reset the board and add the organism in
+    simReset(sim, member);
+    sim.detector.reset();
+    sim.detector.record(simHash(sim), 0);
+    GoLMetrics metrics;
+    metrics.peakPopulation = (double) simPopulation(sim);
+
+    // Calculate the center of mass
+    double oldXCoM = 0.0;
+    double oldYCoM = 0.0;
+    simCenterOfMass(sim, oldXCoM, oldYCoM);
+    double newXCoM = oldXCoM;
+    double newYCoM = oldYCoM;
+
+    // Step the game forward, every metric from the same boards
+    double changeSum = 0.0;
+    double motionSum = 0.0;
+    vector<double> populations = {metrics.peakPopulation};
+    vector<double> changes = {0.0};
+    vector<double> motion = {0.0};
+    bool repeated = false;
+    metrics.lifespan = (double) maxSteps;
+    for(int k = 1; k <= maxSteps; k++){
+        changes.push_back(simStep(sim));
+        changeSum += changes.back();
+        populations.push_back((double) simPopulation(sim));
+        metrics.peakPopulation = max(metrics.peakPopulation, populations.back());
+
+        // A board that died out keeps the last center of mass
+        simCenterOfMass(sim, newXCoM, newYCoM);
+        double delX = newXCoM - oldXCoM;
+        double delY = newYCoM - oldYCoM;
+        motion.push_back(sqrt(delX * delX + delY * delY));
+        motionSum += motion.back();
+        oldXCoM = newXCoM;
+        oldYCoM = newYCoM;
+
+        // The lifespan needs the first repeat whether or not the simulation stops there
+        if(!repeated && sim.detector.record(simHash(sim), k)){
+            repeated = true;
+            metrics.lifespan = (double) sim.detector.getCycleStart();
+
+            // Once the board repeats the rest of the values go around the cycle and the peak was already seen
+            if(earlyExit){
+                populations.back() = populations[sim.detector.equivalentGeneration(maxSteps)];
+                changeSum = sim.detector.extrapolateSum(changes, maxSteps);
+                motionSum = sim.detector.extrapolateSum(motion, maxSteps);
+                break;
+            }
+        }
+    }
+    metrics.finalPopulation = populations.back();
+    metrics.meanChange = changeSum / ((double) maxSteps);
+    metrics.centerOfMassMotion = motionSum / ((double) maxSteps);
+    return metrics;
+}
+
+char* GameOfLifeGA::placedMember(GoLSimulation& sim, int member, int& placedRows, int& placedCols){
+    placedRows = orgRows;
+    placedCols = orgCols;
+    if(!autoCrop){
+        return population[member];
+    }
+
+    // Bounding box of the cells that are on
+    char* organism = population[member];
+    int top = orgRows;
+    int bottom = -1;
+    int left = orgCols;
+    int right = -1;
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            if(organism[i * orgCols + j]){
+                top = min(top, i);
+                bottom = max(bottom, i);
+                left = min(left, j);
+                right = max(right, j);
+            }
+        }
+    }
+
+    // An empty organism is placed as it is
+    if(bottom < 0){
+        return organism;
+    }
+    placedRows = bottom - top + 1;
+    placedCols = right - left + 1;
+    sim.cropped.resize(placedRows * placedCols);
+    for(int i = 0; i < placedRows; i++){
+        for(int j = 0; j < placedCols; j++){
+            sim.cropped[i * placedCols + j] = organism[(top + i) * orgCols + left + j];
+        }
+    }
+    return sim.cropped.data();
+}
+
+void GameOfLifeGA::simReset(GoLSimulation& sim, int member){
+    int placedRows;
+    int placedCols;
+    char* organism = placedMember(sim, member, placedRows, placedCols);
+    if(boundary == GoLBoundary::Unbounded){
+        // Same place as on the torus so the coordinates line up with the rows x cols window
+        sim.sparse.clear();
+        sim.sparse.addOrganism((rows - placedRows) / 2, (cols - placedCols) / 2, placedRows, placedCols, organism);
+        return;
+    }
+
+    // The fixed size board only runs Conway's rule
+    sim.fixedActive = sim.fixedBoard && rule == findLifeRule(ConwayRule::birth, ConwayRule::survive);
+    if(sim.fixedActive){
+        sim.fixedBoard->addOrganism(placedRows, placedCols, organism);
+    } else {
+        sim.game->addOrganism(placedRows, placedCols, organism);
+    }
+}
+
+long long GameOfLifeGA::simStep(GoLSimulation& sim){
+    if(boundary == GoLBoundary::Unbounded){
+        return sim.sparse.step();
+    } else if(sim.fixedActive){
+        return sim.fixedBoard->step();
+    }
+    return sim.game->step();
+}
+
+long long GameOfLifeGA::simPopulation(GoLSimulation& sim){
+    if(boundary == GoLBoundary::Unbounded){
+        return sim.sparse.getPopulation();
+    } else if(sim.fixedActive){
+        return sim.fixedBoard->getPopulation();
+    }
+    return sim.game->getStatistics().population;
+}
+
+uint64_t GameOfLifeGA::simHash(GoLSimulation& sim){
+    if(boundary == GoLBoundary::Unbounded){
+        return sim.sparse.getHash();
+    } else if(sim.fixedActive){
+        return sim.fixedBoard->getHash();
+    }
+    return sim.game->getHash();
+}
+
+bool GameOfLifeGA::simCenterOfMass(GoLSimulation& sim, double& x, double& y){
+    double numerXCoM = 0.0;
+    double numerYCoM = 0.0;
+    double denomCoM = 0.0;
+    if(boundary == GoLBoundary::Unbounded){
+        denomCoM = (double) sim.sparse.getCoordinateSums(numerYCoM, numerXCoM);
+        numerYCoM += 0.5 * denomCoM;
+        numerXCoM += 0.5 * denomCoM;
+    } else {
+        GoLStatistics stats = sim.fixedActive ? sim.fixedBoard->getStatistics() : sim.game->getStatistics();
+        denomCoM = (double) stats.population;
+        numerYCoM = stats.rowSum + 0.5 * denomCoM;
+        numerXCoM = stats.colSum + 0.5 * denomCoM;
+    }
+    if(denomCoM == 0.0){
+        return false;
+    }
+    x = numerXCoM / denomCoM;
+    y = numerYCoM / denomCoM;
+    return true;
+}
+
 //---------- EXTERNAL FUNCTIONS ----------
+void sparseMembers(GameOfLifeGA& ga, int numMembers, double chance){
+    int sizeMembers = ga.getSizeMembers();
+    char* organism = new char[sizeMembers];
+    for(int member = 0; member < numMembers; member++){
+        for(int i = 0; i < sizeMembers; i++){
+            organism[i] = rng::genRandDouble(0.0, 1.0) < chance;
+        }
+        ga.setMember(member, organism);
+    }
+    delete[](organism);
+}
+
+GoLMetrics referenceMetrics(int rows, int cols, int orgRows, int orgCols, const char* organism, int maxSteps){
+    // Same place as addOrganism
+    vector<char> cells(rows * cols, 0);
+    vector<char> next(rows * cols, 0);
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            cells[((rows - orgRows) / 2 + i) * cols + (cols - orgCols) / 2 + j] = organism[i * orgCols + j] != 0;
+        }
+    }
+
+    // Every board is kept to find the first one that comes back
+    map<vector<char>, int> seen;
+    seen.emplace(cells, 0);
+    GoLMetrics metrics;
+    metrics.lifespan = (double) maxSteps;
+    double x = 0.0;
+    double y = 0.0;
+    double changeSum = 0.0;
+    double motionSum = 0.0;
+    for(int k = 0; k <= maxSteps; k++){
+        if(k > 0){
+            changeSum += referenceStep(cells, next, rows, cols);
+            cells.swap(next);
+            auto found = seen.emplace(cells, k);
+            if(!found.second && metrics.lifespan == (double) maxSteps){
+                metrics.lifespan = (double) found.first->second;
+            }
+        }
+
+        // Center of the cells that are on, a board that died out keeps the last one
+        double population = 0.0;
+        double rowSum = 0.0;
+        double colSum = 0.0;
+        for(int i = 0; i < rows; i++){
+            for(int j = 0; j < cols; j++){
+                if(cells[i * cols + j]){
+                    population++;
+                    rowSum += i;
+                    colSum += j;
+                }
+            }
+        }
+        if(population > 0.0){
+            double newX = colSum / population + 0.5;
+            double newY = rowSum / population + 0.5;
+            if(k > 0){
+                motionSum += sqrt((newX - x) * (newX - x) + (newY - y) * (newY - y));
+            }
+            x = newX;
+            y = newY;
+        }
+        metrics.peakPopulation = max(metrics.peakPopulation, population);
+        metrics.finalPopulation = population;
+    }
+    metrics.meanChange = changeSum / ((double) maxSteps);
+    metrics.centerOfMassMotion = motionSum / ((double) maxSteps);
+    return metrics;
+}
+
 void test_GameOfLife(){
     // Start a Game of Life with a random board
     GameOfLife game = GameOfLife(17, 17);
@@ -637,4 +2087,643 @@ void test_GameOfLife(){
         cout << game;
     }
     cout << "---------------\n";
-}
\ No newline at end of file
+}
+
+void test_activeTiles(){
+    // Boards that do and do not divide evenly into tiles
+    int sizes[][3] = {{256, 256, 16}, {100, 70, 16}, {64, 64, 5}};
+    int numSteps = 300;
+
+    for(auto& size : sizes){
+        int rows = size[0];
+        int cols = size[1];
+
+        // A random soup in one corner that settles into still lifes and oscillators while the rest of the board stays empty
+        GameOfLife game = GameOfLife(rows, cols);
+        game.setTileSize(size[2]);
+        bool** board = game.getBoard();
+        for(int i = 0; i < rows / 3; i++){
+            for(int j = 0; j < cols / 3; j++){
+                board[i][j] = rng::genRandDouble(0.0, 1.0) < 0.35;
+            }
+        }
+
+        // A glider that wraps around the edges, crossing every row of tiles
+        board[rows - 3][cols / 2 + 1] = true;
+        board[rows - 2][cols / 2 + 2] = true;
+        board[rows - 1][cols / 2] = true;
+        board[rows - 1][cols / 2 + 1] = true;
+        board[rows - 1][cols / 2 + 2] = true;
+        game.invalidateTiles();
+
+        // The bit packed board recomputes every cell so it is the reference
+        BitGameOfLife bitGame = BitGameOfLife(rows, cols);
+        bitGame.setBoard(board);
+
+        // Step both forward and compare the changes and the boards
+        bool passed = true;
+        int totalTiles = ((rows + size[2] - 1) / size[2]) * ((cols + size[2] - 1) / size[2]);
+        for(int k = 0; k < numSteps && passed; k++){
+            int changes = game.step();
+            int bitChanges = bitGame.step();
+            passed = changes == bitChanges;
+
+            board = game.getBoard();
+            for(int i = 0; i < rows && passed; i++){
+                for(int j = 0; j < cols && passed; j++){
+                    passed = board[i][j] == bitGame.getCell(i, j);
+                }
+            }
+        }
+        cout << "Active tiles " << rows << "x" << cols << " (" << game.getActiveTiles() << "/" << totalTiles << " active): " << (passed ? "PASSED" : "FAILED") << "\n";
+    }
+}
+
+void test_parallelStep(){
+    // Boards that do and do not divide evenly into bands
+    int sizes[][2] = {{300, 200}, {97, 131}};
+    int numSteps = 100;
+
+    for(auto& size : sizes){
+        int rows = size[0];
+        int cols = size[1];
+
+        // Start both versions from the same random board
+        GameOfLife game = GameOfLife(rows, cols);
+        game.randomBoard(0.3);
+        GameOfLife parallelGame = GameOfLife(game);
+        parallelGame.setThreads(4);
+
+        // Step both forward and compare the changes and the boards
+        bool passed = true;
+        for(int k = 0; k < numSteps && passed; k++){
+            passed = game.step() == parallelGame.step();
+
+            bool** board = game.getBoard();
+            bool** parallelBoard = parallelGame.getBoard();
+            for(int i = 0; i < rows && passed; i++){
+                passed = memcmp(board[i], parallelBoard[i], cols) == 0;
+            }
+        }
+        cout << "Parallel step " << rows << "x" << cols << " with " << parallelGame.getThreads() << " threads: " << (passed ? "PASSED" : "FAILED") << "\n";
+    }
+}
+
+void test_stepMany(){
+    // Boards smaller than a block, not a multiple of the block and larger than the depth in only one direction
+    int sizes[][2] = {{50, 60}, {600, 500}, {5, 700}};
+    int stepCounts[] = {1, 7, 8, 21};
+
+    for(auto& size : sizes){
+        int rows = size[0];
+        int cols = size[1];
+        for(int threads = 1; threads <= 3; threads += 2){
+            bool passed = true;
+            for(int steps : stepCounts){
+                // Start both versions from the same random board
+                GameOfLife game = GameOfLife(rows, cols);
+                game.randomBoard(0.3);
+                GameOfLife blockedGame = GameOfLife(game);
+                blockedGame.setThreads(threads);
+
+                // Step one forward a generation at a time and the other in blocks
+                long long changes = 0;
+                for(int k = 0; k < steps; k++){
+                    changes += game.step();
+                }
+                passed = passed && changes == blockedGame.stepMany(steps);
+
+                // Compare the boards
+                bool** board = game.getBoard();
+                bool** blockedBoard = blockedGame.getBoard();
+                for(int i = 0; i < rows && passed; i++){
+                    passed = memcmp(board[i], blockedBoard[i], cols) == 0;
+                }
+
+                // Both should keep stepping the same afterwards
+                passed = passed && game.step() == blockedGame.step();
+            }
+            cout << "Step many " << rows << "x" << cols << " with " << threads << " threads: " << (passed ? "PASSED" : "FAILED") << "\n";
+        }
+    }
+}
+
+void test_lookupTable(){
+    // Boards with odd and even sizes, under a couple of rules
+    int sizes[][2] = {{64, 64}, {99, 77}, {1000, 1000}};
+    const char* rules[] = {"B3/S23", "B36/S23", "B2/S"};
+    int numSteps = 50;
+
+    for(auto& size : sizes){
+        int rows = size[0];
+        int cols = size[1];
+        for(const char* rule : rules){
+            // Start both versions from the same random board
+            GameOfLife game = GameOfLife(rows, cols);
+            game.setRule(rule);
+            game.randomBoard(0.3);
+            GameOfLife tableGame = GameOfLife(game);
+            tableGame.setKernel(GoLKernel::LookupTable);
+
+            // Step both forward, timing each, and compare the changes and the boards
+            bool passed = true;
+            double rowsTime = 0.0;
+            double tableTime = 0.0;
+            for(int k = 0; k < numSteps && passed; k++){
+                auto start = chrono::steady_clock::now();
+                int changes = game.step();
+                auto middle = chrono::steady_clock::now();
+                int tableChanges = tableGame.step();
+                auto end = chrono::steady_clock::now();
+                rowsTime += chrono::duration<double>(middle - start).count();
+                tableTime += chrono::duration<double>(end - middle).count();
+                passed = changes == tableChanges;
+
+                bool** board = game.getBoard();
+                bool** tableBoard = tableGame.getBoard();
+                for(int i = 0; i < rows && passed; i++){
+                    passed = memcmp(board[i], tableBoard[i], cols) == 0;
+                }
+            }
+            cout << "Lookup table " << rows << "x" << cols << " " << rule << ": " << (passed ? "PASSED" : "FAILED");
+            cout << " (rows " << rowsTime << "s, table " << tableTime << "s)\n";
+        }
+    }
+}
+
+void test_earlyExit(){
+    // The hash kept up while stepping should match hashing the board from scratch, serially and with threads, and not depend on the tile size
+    bool passed = true;
+    for(int threads = 1; threads <= 3 && passed; threads += 2){
+        GameOfLife game = GameOfLife(150, 130);
+        game.setHashing(true);
+        game.setThreads(threads);
+        game.setTileSize(threads == 1 ? GAME_OF_LIFE_DEFAULT_TILE_SIZE : 12);
+        game.randomBoard(0.3);
+        GameOfLife fresh = GameOfLife(150, 130);
+        fresh.setTileSize(threads == 1 ? 5 : 7);
+        for(int k = 0; k < 300 && passed; k++){
+            game.step();
+            game.getBoardSafe(fresh.getBoard());
+            fresh.invalidateTiles();
+            passed = game.getHash() == fresh.getHash();
+        }
+    }
+    cout << "Rolling hash: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Every fitness function should give the same result with and without stopping early
+    char actions[] = {0, 1};
+    int orgRows = 6;
+    int orgCols = 6;
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::CenterOfMassMotion};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "CenterOfMassMotion"};
+    for(GoLBoundary boundary : {GoLBoundary::Toroidal, GoLBoundary::Unbounded}){
+        for(int f = 0; f < 3; f++){
+            GameOfLifeGA ga = GameOfLifeGA(30, orgRows * orgCols, 2, actions, 1, 0.1, 1, 40, 40, functions[f], 1000, orgRows, orgCols, boundary);
+            // Small tiles and sparse members that die out early go to sleep on their own, which the plain stepper below has to agree with
+            ga.setTileSize(4);
+            sparseMembers(ga, 4, 0.1);
+            GameOfLifeGA fullGA = GameOfLifeGA(ga);
+            fullGA.setEarlyExit(false);
+
+            // Time both
+            passed = true;
+            double earlyTime = 0.0;
+            double fullTime = 0.0;
+            for(int member = 0; member < 30 && passed; member++){
+                auto start = chrono::steady_clock::now();
+                double early = ga.fitness(member);
+                auto middle = chrono::steady_clock::now();
+                double full = fullGA.fitness(member);
+                auto end = chrono::steady_clock::now();
+                earlyTime += chrono::duration<double>(middle - start).count();
+                fullTime += chrono::duration<double>(end - middle).count();
+                passed = fabs(early - full) <= 1e-9 * max(1.0, fabs(full));
+
+                // Both should also match the plain stepper on the torus, checked on the first few members as it never stops early
+                if(boundary == GoLBoundary::Toroidal && member < 8){
+                    char* organism = ga.getMember(member);
+                    double expected = ga.projectMetrics(referenceMetrics(40, 40, orgRows, orgCols, organism, 1000), functions[f]);
+                    passed = passed && fabs(full - expected) <= 1e-9 * max(1.0, fabs(expected));
+                    delete[] organism;
+                }
+            }
+            cout << "Early exit " << names[f] << (boundary == GoLBoundary::Unbounded ? " unbounded: " : " toroidal: ") << (passed ? "PASSED" : "FAILED");
+            cout << " (early " << earlyTime << "s, full " << fullTime << "s)\n";
+        }
+    }
+
+    // The lifespan should be the first generation whose board was already seen, found here by keeping every board
+    int maxSteps = 300;
+    GameOfLifeGA ga = GameOfLifeGA(20, orgRows * orgCols, 2, actions, 1, 0.1, 1, 24, 24, GoLFitnessFunction::Lifespan, maxSteps, orgRows, orgCols);
+    ga.setTileSize(4);
+    sparseMembers(ga, 5, 0.1);
+    passed = true;
+    for(int member = 0; member < 20 && passed; member++){
+        char* organism = ga.getMember(member);
+        passed = ga.fitness(member) == referenceMetrics(24, 24, orgRows, orgCols, organism, maxSteps).lifespan;
+        delete[] organism;
+    }
+    cout << "Lifespan: " << (passed ? "PASSED" : "FAILED") << "\n";
+}
+
+void test_statistics(){
+    // The statistics gathered while stepping should match counting the board directly, for every kernel and serially and with threads
+    bool passed = true;
+    for(int setup = 0; setup < 4 && passed; setup++){
+        GameOfLife game = GameOfLife(170, 150);
+        game.setStatistics(true);
+        game.setThreads(setup % 2 == 0 ? 1 : 3);
+        game.setKernel(setup < 2 ? GoLKernel::Rows : GoLKernel::LookupTable);
+        game.randomBoard(0.25);
+        for(int k = 0; k < 300 && passed; k++){
+            game.step();
+            GoLStatistics expected;
+            bool** board = game.getBoard();
+            for(int i = 0; i < 170; i++){
+                for(int j = 0; j < 150; j++){
+                    if(board[i][j]){
+                        expected.population++;
+                        expected.rowSum += i;
+                        expected.colSum += j;
+                        expected.minRow = min(expected.minRow, i);
+                        expected.maxRow = max(expected.maxRow, i);
+                        expected.minCol = min(expected.minCol, j);
+                        expected.maxCol = max(expected.maxCol, j);
+                    }
+                }
+            }
+            GoLStatistics stats = game.getStatistics();
+            passed = stats.population == expected.population && stats.rowSum == expected.rowSum && stats.colSum == expected.colSum;
+            passed = passed && stats.minRow == expected.minRow && stats.maxRow == expected.maxRow && stats.minCol == expected.minCol && stats.maxCol == expected.maxCol;
+        }
+    }
+    cout << "Statistics: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Time the center of mass fitness with the statistics gathered while stepping against counting the whole board after every step
+    char actions[] = {0, 1};
+    GameOfLifeGA ga = GameOfLifeGA(20, 64, 2, actions, 1, 0.1, 1, 256, 256, GoLFitnessFunction::CenterOfMassMotion, 500, 8, 8);
+    ga.setEarlyExit(false);
+    GameOfLifeGA scanGA = GameOfLifeGA(ga);
+    scanGA.setStatistics(false);
+    passed = true;
+    double fusedTime = 0.0;
+    double scanTime = 0.0;
+    for(int member = 0; member < 20 && passed; member++){
+        auto start = chrono::steady_clock::now();
+        double fused = ga.fitness(member);
+        auto middle = chrono::steady_clock::now();
+        double scan = scanGA.fitness(member);
+        auto end = chrono::steady_clock::now();
+        fusedTime += chrono::duration<double>(middle - start).count();
+        scanTime += chrono::duration<double>(end - middle).count();
+        passed = fused == scan;
+    }
+    cout << "Center of mass fitness: " << (passed ? "PASSED" : "FAILED") << " (fused " << fusedTime << "s, scan " << scanTime << "s)\n";
+}
+
+void test_lightCone(){
+    // Organisms should step the same as the plain stepper from the first step on, a lone cell dies and stays dead, a blinker turns and a block stays
+    // Organisms that are mostly gone after one step are the ones that could take the empty back buffer for an earlier generation
+    int orgRows = 12;
+    int orgCols = 10;
+    char organism[12 * 10];
+    char sparseOrganism[12 * 10];
+    for(int i = 0; i < orgRows * orgCols; i++){
+        organism[i] = rng::genRandDouble(0.0, 1.0) < 0.4;
+        sparseOrganism[i] = rng::genRandDouble(0.0, 1.0) < 0.1;
+    }
+    char lone[] = {1};
+    char blinker[] = {1, 1, 1};
+    char block[] = {1, 1, 1, 1};
+    struct { int orgRows; int orgCols; char* cells; } shapes[] = {{1, 1, lone}, {1, 3, blinker}, {2, 2, block}, {orgRows, orgCols, sparseOrganism}, {orgRows, orgCols, organism}};
+    int boards[][2] = {{27, 27}, {60, 44}};
+    bool passed = true;
+    for(int setup = 0; setup < 8 && passed; setup++){
+        int rows = boards[setup / 4][0];
+        int cols = boards[setup / 4][1];
+        for(auto& shape : shapes){
+            GameOfLife game = GameOfLife(rows, cols);
+            game.setTileSize(setup % 2 == 0 ? GAME_OF_LIFE_DEFAULT_TILE_SIZE : 4);
+            game.setKernel(setup % 4 < 2 ? GoLKernel::Rows : GoLKernel::LookupTable);
+            game.setStatistics(true);
+            game.addOrganism(shape.orgRows, shape.orgCols, shape.cells);
+
+            // Same place as addOrganism
+            vector<char> cells(rows * cols, 0);
+            vector<char> next(rows * cols, 0);
+            for(int i = 0; i < shape.orgRows; i++){
+                for(int j = 0; j < shape.orgCols; j++){
+                    cells[((rows - shape.orgRows) / 2 + i) * cols + (cols - shape.orgCols) / 2 + j] = shape.cells[i * shape.orgCols + j];
+                }
+            }
+            for(int k = 0; k < 60 && passed; k++){
+                passed = game.step() == referenceStep(cells, next, rows, cols);
+                cells.swap(next);
+                bool** board = game.getBoard();
+                long long population = 0;
+                for(int i = 0; i < rows && passed; i++){
+                    for(int j = 0; j < cols && passed; j++){
+                        passed = board[i][j] == (bool) cells[i * cols + j];
+                        population += cells[i * cols + j];
+                    }
+                }
+                passed = passed && game.getStatistics().population == population;
+            }
+        }
+    }
+    cout << "Light cone against a plain stepper: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // A small organism on a large board should step the same with and without the light cone, for every kernel and serially and with threads
+    passed = true;
+    for(int setup = 0; setup < 4 && passed; setup++){
+        GameOfLife cone = GameOfLife(300, 260);
+        cone.setThreads(setup % 2 == 0 ? 1 : 3);
+        cone.setKernel(setup < 2 ? GoLKernel::Rows : GoLKernel::LookupTable);
+        cone.setHashing(true);
+        cone.setStatistics(true);
+        GameOfLife full = GameOfLife(cone);
+        cone.addOrganism(orgRows, orgCols, organism);
+        full.addOrganism(orgRows, orgCols, organism);
+        full.invalidateTiles();
+        for(int k = 0; k < 400 && passed; k++){
+            passed = cone.step() == full.step();
+            bool** coneBoard = cone.getBoard();
+            bool** fullBoard = full.getBoard();
+            for(int i = 0; i < 300 && passed; i++){
+                passed = memcmp(coneBoard[i], fullBoard[i], 260) == 0;
+            }
+            GoLStatistics coneStats = cone.getStatistics();
+            GoLStatistics fullStats = full.getStatistics();
+            passed = passed && cone.getHash() == full.getHash() && coneStats.population == fullStats.population && coneStats.rowSum == fullStats.rowSum && coneStats.colSum == fullStats.colSum;
+        }
+    }
+    cout << "Light cone: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Time the first steps of an organism on a large board
+    GameOfLife cone = GameOfLife(1024, 1024);
+    GameOfLife full = GameOfLife(1024, 1024);
+    double coneTime = 0.0;
+    double fullTime = 0.0;
+    for(int r = 0; r < 20; r++){
+        cone.addOrganism(orgRows, orgCols, organism);
+        full.addOrganism(orgRows, orgCols, organism);
+        full.invalidateTiles();
+        auto start = chrono::steady_clock::now();
+        for(int k = 0; k < 30; k++){
+            cone.step();
+        }
+        auto middle = chrono::steady_clock::now();
+        for(int k = 0; k < 30; k++){
+            full.step();
+        }
+        auto end = chrono::steady_clock::now();
+        coneTime += chrono::duration<double>(middle - start).count();
+        fullTime += chrono::duration<double>(end - middle).count();
+    }
+    cout << "First 30 steps on 1024 x 1024: light cone " << coneTime << "s, whole board " << fullTime << "s\n";
+
+    // Trimming the organisms should not change the fitness functions that do not depend on where the organism is
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::Lifespan, GoLFitnessFunction::CenterOfMassMotion};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "Lifespan", "CenterOfMassMotion"};
+    for(int f = 0; f < 4; f++){
+        // The center of mass jumps when the organism wraps around the torus so it is only compared unbounded
+        GoLBoundary boundary = f == 3 ? GoLBoundary::Unbounded : GoLBoundary::Toroidal;
+        GameOfLifeGA ga = GameOfLifeGA(30, 64, 2, actions, 1, 0.1, 1, 48, 48, functions[f], 300, 8, 8, boundary);
+        GameOfLifeGA cropGA = GameOfLifeGA(ga);
+        cropGA.setAutoCrop(true);
+        passed = true;
+        for(int member = 0; member < 30 && passed; member++){
+            double plain = ga.fitness(member);
+            double cropped = cropGA.fitness(member);
+            passed = fabs(plain - cropped) <= 1e-9 * max(1.0, fabs(plain));
+        }
+        cout << "Auto crop " << names[f] << ": " << (passed ? "PASSED" : "FAILED") << "\n";
+    }
+}
+
+void test_packing(){
+    // Packing the unbounded population onto one plane should give every member the fitness it gets alone
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::CenterOfMassMotion, GoLFitnessFunction::Lifespan};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "CenterOfMassMotion", "Lifespan"};
+    for(int f = 0; f < 4; f++){
+        bool passed = true;
+        double packedTime = 0.0;
+        double aloneTime = 0.0;
+        for(int setup = 0; setup < 3 && passed; setup++){
+            GameOfLifeGA packed = GameOfLifeGA(40, 13 * 13, 2, actions, 1, 0.1, 1, 27, 27, functions[f], 120, 13, 13, GoLBoundary::Unbounded);
+            packed.setEarlyExit(setup != 1);
+            packed.setAutoCrop(setup == 2);
+            GameOfLifeGA alone = GameOfLifeGA(packed);
+            packed.setPacking(true);
+
+            auto start = chrono::steady_clock::now();
+            packed.evalFitness();
+            auto middle = chrono::steady_clock::now();
+            alone.evalFitness();
+            auto end = chrono::steady_clock::now();
+            packedTime += chrono::duration<double>(middle - start).count();
+            aloneTime += chrono::duration<double>(end - middle).count();
+
+            for(int member = 0; member < 40 && passed; member++){
+                double expected = alone.getFitness(member);
+                passed = fabs(packed.getFitness(member) - expected) <= 1e-9 * max(1.0, fabs(expected));
+            }
+        }
+        cout << "Packed " << names[f] << ": " << (passed ? "PASSED" : "FAILED") << ", packed " << packedTime << "s, one at a time " << aloneTime << "s\n";
+    }
+
+    // The regions should add up to the whole plane
+    SparseGameOfLife plane;
+    plane.setRegions(2, 3);
+    for(int region = 0; region < 7; region++){
+        for(int i = 0; i < 200; i++){
+            plane.setCell(plane.getRegionRow(region) + rng::genRandInt(0, 127), plane.getRegionCol(region) + rng::genRandInt(0, 127), true);
+        }
+    }
+    SparseRegionStatistics stats[7];
+    long long changes[7] = {};
+    long long total = plane.step(changes);
+    plane.getRegionStatistics(7, stats);
+    long long population = 0;
+    long long changed = 0;
+    uint64_t hash = 0;
+    for(int region = 0; region < 7; region++){
+        population += stats[region].population;
+        changed += changes[region];
+        hash ^= stats[region].hash;
+    }
+    bool passed = population == plane.getPopulation() && changed == total && hash == plane.getHash();
+    plane.clearRegion(3);
+    plane.getRegionStatistics(7, stats);
+    passed = passed && stats[3].population == 0 && plane.getPopulation() == population - (population - stats[0].population - stats[1].population - stats[2].population - stats[4].population - stats[5].population - stats[6].population);
+    cout << "Sparse regions: " << (passed ? "PASSED" : "FAILED") << "\n";
+}
+
+void test_parallelFitness(){
+    // Evaluating on several threads should give bit for bit the same fitness as one thread, on every path that hands out work
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::CenterOfMassMotion, GoLFitnessFunction::Lifespan};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "CenterOfMassMotion", "Lifespan"};
+    const char* setups[] = {"batches", "one at a time", "fixed size board", "unbounded", "HighLife"};
+    for(int f = 0; f < 4; f++){
+        bool passed = true;
+        double serialTime = 0.0;
+        double parallelTime = 0.0;
+        for(int setup = 0; setup < 5 && passed; setup++){
+            GameOfLifeGA serial = GameOfLifeGA(200, 13 * 13, 2, actions, 1, 0.1, 1, 27, 27, functions[f], 150, 13, 13, setup == 3 ? GoLBoundary::Unbounded : GoLBoundary::Toroidal);
+            serial.setBatching(setup == 0);
+            // Small tiles and sparse members that die out early go to sleep on their own, which the plain stepper below has to agree with
+            serial.setTileSize(4);
+            sparseMembers(serial, 5, 0.1);
+            if(setup == 2){
+                serial.setFixedBoard(new FixedGameOfLife<27, 27>());
+            } else if(setup == 4){
+                serial.setRule("B36/S23");
+            }
+            GameOfLifeGA parallel = GameOfLifeGA(serial);
+            parallel.setThreads(2);
+            parallel.setFitnessThreads(4);
+            // The board of the genetic algorithm leaves the threads to the members
+            passed = parallel.getThreads() == 1;
+
+            // A second evaluation reuses the workers, a third rebuilds them for the new rule
+            for(int repeat = 0; repeat < 3 && passed; repeat++){
+                if(repeat == 2){
+                    serial.setRule(setup == 4 ? "B3/S23" : "B36/S23");
+                    parallel.setRule(setup == 4 ? "B3/S23" : "B36/S23");
+                }
+                auto start = chrono::steady_clock::now();
+                serial.evalFitness();
+                auto middle = chrono::steady_clock::now();
+                parallel.evalFitness();
+                auto end = chrono::steady_clock::now();
+                serialTime += chrono::duration<double>(middle - start).count();
+                parallelTime += chrono::duration<double>(end - middle).count();
+
+                for(int member = 0; member < 200 && passed; member++){
+                    passed = serial.getFitness(member) == parallel.getFitness(member);
+                }
+
+                // Both should also match the plain stepper on the torus with Conway's rule, checked on the first few members
+                for(int member = 0; member < 10 && passed && setup < 3 && repeat < 2; member++){
+                    char* organism = serial.getMember(member);
+                    double expected = serial.projectMetrics(referenceMetrics(27, 27, 13, 13, organism, 150), functions[f]);
+                    passed = fabs(serial.getFitness(member) - expected) <= 1e-9 * max(1.0, fabs(expected));
+                    delete[] organism;
+                }
+                passed = passed && serial.getAverageFitness(false) == parallel.getAverageFitness(false);
+                if(!passed){
+                    cout << "Parallel " << names[f] << " failed with " << setups[setup] << "\n";
+                }
+            }
+        }
+        cout << "Parallel fitness " << names[f] << ": " << (passed ? "PASSED" : "FAILED") << ", 1 thread " << serialTime << "s, 4 threads " << parallelTime << "s on " << thread::hardware_concurrency() << " hardware threads\n";
+    }
+}
+
+void test_metrics(){
+    // One pass of the metrics should give what each fitness function gives on its own, and the weighted fitness what the weights make of them
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::CenterOfMassMotion, GoLFitnessFunction::Lifespan};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "CenterOfMassMotion", "Lifespan"};
+    GoLBoundary boundaries[] = {GoLBoundary::Toroidal, GoLBoundary::Unbounded};
+    const char* boundaryNames[] = {"torus", "unbounded"};
+    GoLMetrics weights;
+    weights.finalPopulation = 1.0;
+    weights.meanChange = 2.0;
+    weights.centerOfMassMotion = 3.0;
+    weights.peakPopulation = 0.5;
+    weights.lifespan = 0.25;
+    for(int b = 0; b < 2; b++){
+        for(int early = 1; early >= 0; early--){
+            GameOfLifeGA measured = GameOfLifeGA(200, 13 * 13, 2, actions, 1, 0.1, 1, 27, 27, GoLFitnessFunction::Weighted, 150, 13, 13, boundaries[b]);
+            measured.setEarlyExit(early);
+            measured.setFitnessWeights(weights);
+            // Small tiles and sparse members that die out early go to sleep on their own, which the plain stepper below has to agree with
+            measured.setTileSize(4);
+            sparseMembers(measured, 10, 0.1);
+            auto start = chrono::steady_clock::now();
+            vector<GoLMetrics> metrics = measured.evalMetrics();
+            double metricsTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            bool passed = true;
+            double separateTime = 0.0;
+            for(int f = 0; f < 4 && passed; f++){
+                // One member at a time like the metrics, the batches can not find the lifespan
+                GameOfLifeGA single = GameOfLifeGA(measured);
+                single.setFitnessFunction(functions[f]);
+                single.setBatching(false);
+                start = chrono::steady_clock::now();
+                single.evalFitness();
+                if(functions[f] != GoLFitnessFunction::Lifespan){
+                    separateTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                }
+                for(int member = 0; member < 200 && passed; member++){
+                    double expected = single.getFitness(member);
+                    passed = fabs(measured.projectMetrics(metrics[member], functions[f]) - expected) <= 1e-9 * max(1.0, fabs(expected));
+                }
+                if(!passed){
+                    cout << "Metrics " << names[f] << " failed\n";
+                }
+            }
+
+            // The weighted fitness one member at a time and from the trajectories of differential evaluation
+            measured.evalFitness();
+            GameOfLifeGA differential = GameOfLifeGA(measured);
+            differential.setDifferential(true);
+            differential.evalFitness();
+            for(int member = 0; member < 200 && passed; member++){
+                double expected = measured.projectMetrics(metrics[member], GoLFitnessFunction::Weighted);
+                passed = measured.getFitness(member) == expected;
+                passed = passed && fabs(differential.getFitness(member) - expected) <= 1e-9 * max(1.0, expected);
+                passed = passed && metrics[member].peakPopulation >= metrics[member].finalPopulation && metrics[member].lifespan <= 150.0;
+            }
+
+            // Every metric on the torus should match the plain stepper, checked on the first few members
+            for(int member = 0; member < 20 && passed && boundaries[b] == GoLBoundary::Toroidal; member++){
+                char* organism = measured.getMember(member);
+                GoLMetrics expected = referenceMetrics(27, 27, 13, 13, organism, 150);
+                delete[] organism;
+                const double values[] = {metrics[member].finalPopulation, metrics[member].meanChange, metrics[member].centerOfMassMotion, metrics[member].peakPopulation, metrics[member].lifespan};
+                const double expectedValues[] = {expected.finalPopulation, expected.meanChange, expected.centerOfMassMotion, expected.peakPopulation, expected.lifespan};
+                for(int m = 0; m < 5 && passed; m++){
+                    passed = fabs(values[m] - expectedValues[m]) <= 1e-9 * max(1.0, fabs(expectedValues[m]));
+                }
+            }
+            cout << "Metrics " << boundaryNames[b] << (early ? "" : " without early exit") << ": " << (passed ? "PASSED" : "FAILED") << ", three fitness functions " << separateTime << "s, one pass of the metrics " << metricsTime << "s\n";
+        }
+    }
+}
+
+void test_steadyState(){
+    // Every member should keep the fitness of its organism and the best member should never be replaced, on one thread and on several
+    // The lifespan fitness stops at very different steps for different organisms, which is what holds up the generations
+    char actions[] = {0, 1};
+    for(int numThreads : {1, 4}){
+        GameOfLifeGA generational = GameOfLifeGA(60, 10 * 10, 2, actions, 1, 0.02, 1, 27, 27, GoLFitnessFunction::Lifespan, 300, 10, 10);
+        generational.setFitnessThreads(numThreads);
+        GameOfLifeGA steady = GameOfLifeGA(generational);
+        double best = steady.getFitness(steady.getMostFit(true));
+
+        // The same number of evaluations both ways
+        auto start = chrono::steady_clock::now();
+        generational.train(5);
+        auto middle = chrono::steady_clock::now();
+        steady.trainSteadyState(4 * 60);
+        auto end = chrono::steady_clock::now();
+
+        GameOfLifeGA check = GameOfLifeGA(steady);
+        check.setFitnessThreads(1);
+        double total = 0.0;
+        bool passed = steady.getFitness(steady.getMostFit(false)) >= best;
+        for(int member = 0; member < 60 && passed; member++){
+            passed = steady.getFitness(member) == check.fitness(member);
+            total += steady.getFitness(member);
+        }
+        passed = passed && fabs(steady.getAverageFitness(false) * 60.0 - total) <= 1e-9 * max(1.0, total);
+        cout << "Steady state " << numThreads << (numThreads == 1 ? " thread" : " threads") << ": " << (passed ? "PASSED" : "FAILED") << ", average fitness " << steady.getAverageFitness(false) << ", generations " << chrono::duration<double>(middle - start).count() << "s, steady state " << chrono::duration<double>(end - middle).count() << "s\n";
+    }
+}
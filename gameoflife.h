@@ -1,12 +1,50 @@
 #ifndef GAME_OF_LIFE_H
 #define GAME_OF_LIFE_H
 
+#include <climits>
+#include <vector>
+
 #include "geneticsolver.h"
+#include "threadpool.h"
+#include "sparsegameoflife.h"
+#include "liferule.h"
+#include "cycledetector.h"
+#include "lifetrajectory.h"
 
 //---------- CONSTANTS ----------
 // Default board size
 const int GAME_OF_LIFE_DEFAULT_ROWS = 10;
 const int GAME_OF_LIFE_DEFAULT_COLS = 10;
+// Alignment, in bytes, of the board memory and of the start of every row
+const int GAME_OF_LIFE_ALIGNMENT = 64;
+// Default width and height, in cells, of the tiles used to skip quiet regions of the board
+const int GAME_OF_LIFE_DEFAULT_TILE_SIZE = 32;
+// Number of generations stepMany() advances a block before writing it back to the board
+const int GAME_OF_LIFE_TEMPORAL_DEPTH = 8;
+// Width and height, in cells, of the blocks used by stepMany() including the overlap - two blocks per thread should fit in L2
+const int GAME_OF_LIFE_TEMPORAL_BLOCK = 256;
+
+// Kernel used by step() to compute the active tiles
+enum class GoLKernel {
+    // Counts the neighbors of every cell with the row kernel of the rule - vectorized for Conway's rule
+    Rows,
+    // Resolves every 2x2 block with a single lookup of its 4x4 neighborhood in a 64K table - a fast path for machines without wide vector units
+    LookupTable
+};
+
+// Statistics of the cells that are on, gathered tile by tile while stepping
+struct GoLStatistics {
+    // Number of cells that are on
+    long long population = 0;
+    // Sums of the row and column indices of the cells that are on
+    long long rowSum = 0;
+    long long colSum = 0;
+    // Bounding box of the cells that are on, inclusive - empty (min > max) if there are none
+    int minRow = INT_MAX;
+    int maxRow = -1;
+    int minCol = INT_MAX;
+    int maxCol = -1;
+};
 
 class GameOfLife{
     public:
@@ -19,17 +57,55 @@ class GameOfLife{
 
         //---------- UTILITIES ----------
         // Adds the organism to the board. Allows for both bool arrays (which match the data structure here) and char arrays which match the genetic algorithm code
+        // The following steps only compute the light cone of the organism, the cells its influence can have reached, until it reaches an edge of the board
         void addOrganism(int orgRows, int orgCols, bool* organism);
         void addOrganism(int orgRows, int orgCols, char* organism);
         // Generates a random board with chance being the chance (percent as decimal) that a board state starts occupied (true)
         void randomBoard(double chance);
         // Performs a single step of the game of life counting the net number of tiles changed
+        // Only the active tiles are recomputed, the rest already hold their next state in the back buffer
         int step();
+        // Performs the number of steps, advancing cache sized blocks several generations at a time, and returns the total number of tiles changed
+        // Gives the same board as calling step() the same number of times, but is meant for dense boards much larger than the cache
+        long long stepMany(int steps);
         // Creates a copy of the board overwriting the data - provides write protection
         void getBoardSafe(bool** data);
         // Provides direct access to the board through a copy of the pointer - gives user direct access to the board and is not write safe
+        // Call invalidateTiles() after writing to the board through this pointer
         bool** getBoard();
-        
+        // Marks every tile as active so the next steps recompute the whole board
+        void invalidateTiles();
+        // Returns a 64 bit hash of the board, the empty board hashes to 0
+        // The same board hashes the same for any tile size, kernel and number of threads
+        // Kept up to date tile by tile while stepping if hashing is on, otherwise the whole board is hashed on every call
+        uint64_t getHash();
+        // Returns the population, index sums and bounding box of the board
+        // Kept up to date tile by tile while stepping if statistics are on, otherwise the whole board is counted on every call
+        GoLStatistics getStatistics();
+
+        //---------- ACCESSORS ----------
+        int getTileSize() const;
+        int getThreads() const;
+        // Rule in B/S notation
+        string getRule() const;
+        GoLKernel getKernel() const;
+        // Returns true if the other board has the same size, rule, kernel, tile size, hashing and statistics, so both step the same way
+        bool sameSettings(const GameOfLife& other) const;
+        // Number of tiles that will be recomputed by the next step
+        int getActiveTiles() const;
+
+        //---------- MUTATORS ----------
+        void setTileSize(int tileSize);
+        // Switches to a Life-like rule given in B/S notation (e.g. "B36/S23"), returns false and keeps the current rule if it is not one of the precompiled rules
+        // Note: the other engines (BitGameOfLife, SparseGameOfLife, HashLife) only run Conway's rule
+        bool setRule(const string& rule);
+        void setKernel(GoLKernel kernel);
+        // Turns on updating the hash of the board as part of every step
+        void setHashing(bool hashing);
+        // Turns on gathering the statistics of the board as part of every step
+        void setStatistics(bool statistics);
+        // Steps the board with the number of threads, each taking bands of rows - 1 steps serially, 0 or less uses every hardware thread
+        void setThreads(int numThreads);
 
         //---------- DEBUGGING UTILITIES ----------
         // Prints out the differences
@@ -42,26 +118,155 @@ class GameOfLife{
         // The number of columns in the game of life board
         int cols;
         // The board itself
+        // Rows -1 and rows and columns -1 and cols are a halo that holds a copy of the opposite edge for the wrap around
         bool** board;
+        // The board the next step is written into, swapped with board at the end of every step
+        bool** nextBoard;
+        // Contiguous, aligned memory behind the two boards
+        bool* boardData;
+        bool* nextBoardData;
+        // Number of bytes between the starts of two consecutive rows
+        int stride;
+        // Rule applied by every step, Conway's Game of Life by default
+        const LifeRuleEntry* rule;
+        // Kernel used for the active tiles
+        GoLKernel kernel;
+        // 4x4 block table of the rule, only set for the lookup table kernel
+        const uint8_t* blockTable;
+        // Width and height of a tile in cells, the tiles on the bottom and right edges may be smaller
+        int tileSize;
+        // Number of tiles down and across the board
+        int tileRows;
+        int tileCols;
+        // Tiles that have to be recomputed by the next step
+        bool* tileActive;
+        // Tiles whose current state differs from the state two steps ago - the rest are stable or have period 2
+        bool* tileDirty;
+        // Number of cells each tile changed the last time it was computed
+        int* tileChanges;
+        // Number of active tiles
+        int numActive;
+        // False until a step has been taken since the tiles were invalidated, the back buffer does not hold a real previous step until then
+        bool tilesValid;
+        // Copy of two rows of the back buffer for every thread, used to compare against the state two steps ago
+        bool* scratchRow;
+        // Workers for the parallel step, nullptr when stepping serially
+        ThreadPool* pool;
+        // Number of cells changed by every row of tiles in the current step
+        int* bandChanges;
+        // Which of the two buffers the board currently is
+        int front;
+        // Keeps the hashes up to date while stepping
+        bool hashing;
+        // Hash of every tile in each of the two buffers - a tile that is not recomputed keeps the hash it had two steps ago along with its state
+        uint64_t* tileHashes;
+        // Hash of each of the two buffers, the XOR of their tile hashes
+        uint64_t boardHashes[2];
+        // Whether the hashes of each of the two buffers match their contents
+        bool hashValid[2];
+        // Change in the hash from every row of tiles in the current step
+        uint64_t* bandHashes;
+        // Keeps the statistics up to date while stepping
+        bool statistics;
+        // Statistics of every tile in each of the two buffers, kept the same way as the tile hashes
+        GoLStatistics* tileStatistics;
+        // Whether the statistics of each of the two buffers match their contents
+        bool statisticsValid[2];
+        // Only the rows [coneTop, coneBottom) and columns [coneLeft, coneRight) are stepped while the light cone is active
+        // It starts as the organism added to an empty board and grows by a cell on every side each step until it reaches an edge
+        bool coneActive;
+        int coneTop;
+        int coneBottom;
+        int coneLeft;
+        int coneRight;
 
-        //---------- PROTECTED UTILITIES ----------        
+        //---------- PROTECTED UTILITIES ----------
+        // Allocates the memory for both boards
+        void allocBoard();
         // Deletes the board data
         void deleteBoard();
         // Sets all the data in the board to 0
         void resetBoard();
+        // Copies the opposite edges of the board into the halo
+        void refreshHalo();
+        // Allocates the tile flags, all tiles start active
+        void allocTiles();
+        // Deletes the tile flags
+        void deleteTiles();
+        // Activates every tile next to a dirty tile, including the dirty tile itself
+        void activateTiles();
+        // Computes the next state of the active tiles in a row of tiles, returning the number of cells changed
+        // When hashing the tile hashes of the next board are updated and the change to the board hash is XORed into hashDelta
+        int stepTileRow(int tileRow, bool* scratch, uint64_t& hashDelta);
+        // Starts the light cone at the region, every cell outside of it must be off in both buffers
+        void startLightCone(int top, int bottom, int left, int right);
+        // Hashes every tile of the board from scratch
+        void rehashBoard();
+        // Counts the statistics of every tile of the board from scratch
+        void recountStatistics();
+        // Advances the block with the core at (rowStart, colStart) the number of generations from board into nextBoard using the two scratch blocks
+        long long stepBlock(int rowStart, int colStart, int generations, bool* scratchA, bool* scratchB);
 };
 
 enum class GoLFitnessFunction {
     FinalStepTiles,
     AverageChangeTiles,
-    CenterOfMassMotion
+    CenterOfMassMotion,
+    // Number of generations until the pattern dies out or settles into a still life or oscillator - rewards methuselahs
+    Lifespan,
+    // Sum of the metrics of the simulation times the weights set on the GameOfLifeGA - mixes the others at the cost of a single simulation
+    Weighted
+};
+
+// Edges of the simulation used by the fitness functions
+enum class GoLBoundary {
+    // The rows x cols board wraps around, patterns that leave one side come back on the other
+    Toroidal,
+    // An unbounded plane, patterns are free to leave the rows x cols window and never come back
+    Unbounded
+};
+
+// Everything the fitness functions measure about the simulation of one member, collected in a single pass
+struct GoLMetrics {
+    // Number of tiles on after the last step, the FinalStepTiles fitness
+    double finalPopulation = 0.0;
+    // Average number of tiles changed per step, the AverageChangeTiles fitness
+    double meanChange = 0.0;
+    // Average distance the center of mass moved per step, the CenterOfMassMotion fitness
+    double centerOfMassMotion = 0.0;
+    // Largest number of tiles on at any generation
+    double peakPopulation = 0.0;
+    // Generations until the board repeats, the maximum number of steps if it does not - the Lifespan fitness
+    double lifespan = 0.0;
+};
+
+class BatchGameOfLife;
+class LifeEngine;
+class FixedLife;
+class TranspositionTable;
+class FitnessCache;
+
+// Everything a GameOfLifeGA changes while it simulates one member, each thread evaluating the population has its own
+struct GoLSimulation {
+    // Board of the torus - the GameOfLifeGA itself for the calling thread, a copy of it for the other threads
+    GameOfLife* game = nullptr;
+    // Simulation used for the unbounded boundary
+    SparseGameOfLife sparse;
+    // Fixed size board used instead of the built in simulation where possible, nullptr if none
+    FixedLife* fixedBoard = nullptr;
+    // Whether the current simulation is running on the fixed size board
+    bool fixedActive = false;
+    // Watches the simulation for repeated boards
+    CycleDetector detector;
+    // The last trimmed organism
+    vector<char> cropped;
 };
 
 class GameOfLifeGA : public GeneticAlgorithm, public GameOfLife {
     public:
         //---------- CONSTRUCTORS & DESTRUCTOR ----------
         GameOfLifeGA();
-        GameOfLifeGA(int sizePopulation, int sizeMembers, int numActions, char* actions, int crossovers, double mutationRate, int totalGens, int rows, int cols, GoLFitnessFunction fitnessFunc, int maxSteps, int orgRows, int orgCols);
+        GameOfLifeGA(int sizePopulation, int sizeMembers, int numActions, char* actions, int crossovers, double mutationRate, int totalGens, int rows, int cols, GoLFitnessFunction fitnessFunc, int maxSteps, int orgRows, int orgCols, GoLBoundary boundary = GoLBoundary::Toroidal);
         GameOfLifeGA(const GameOfLifeGA & other);
         GameOfLifeGA& operator=(const GameOfLifeGA & other);
         ~GameOfLifeGA();
@@ -69,29 +274,184 @@ class GameOfLifeGA : public GeneticAlgorithm, public GameOfLife {
         //---------- GENETIC ALGORITHM FUNCTIONS ----------
         // Fitness function for the genetic algorithm
         double fitness(int member);
+        // Fitness of the member on the simulation of the worker of the fitness threads
+        double workerFitness(int member, int worker);
+        // Runs the task on every fitness thread, each with a simulation of its own, or only on the calling thread if there is one or an engine
+        void runFitnessWorkers(const function<void(int)>& task);
+        // Evaluates the fitness of the whole population, simulating up to 64 members at once with BatchGameOfLife when batching is on
+        // Unbounded members are all packed onto one plane when packing is on
+        // Members on the torus are re-simulated from the closest trajectory of the last evaluation when differential evaluation is on
+        // Falls back to one member at a time for rules other than Conway's and the lifespan fitness on the torus, and for the weighted fitness outside differential evaluation
+        // The batches or members are spread over the fitness threads when there are more than one
+        void evalFitness();
 
         //---------- UTILITIES ----------
         // Creates an animation of the given member
         void animateMember(int member, int steps);
+        // Simulates the member once and measures every metric, the same values the fitness functions give
+        GoLMetrics evalMetrics(int member);
+        // Measures every member of the population with one simulation each, spread over the fitness threads
+        vector<GoLMetrics> evalMetrics();
+        // Fitness the fitness function gives a member with the metrics, the weighted fitness uses the weights set on the genetic algorithm
+        double projectMetrics(const GoLMetrics& metrics, GoLFitnessFunction fitnessFunc) const;
+
+        //---------- MUTATORS ----------
+        // Changes the fitness function, keeping the population
+        void setFitnessFunction(GoLFitnessFunction fitnessFunc);
+        // Stops simulating a member as soon as its board repeats and works out the rest of the steps from the cycle, on by default
+        void setEarlyExit(bool earlyExit);
+        // Evaluates the population in batches of 64 members, on by default
+        void setBatching(bool batching);
+        // Evaluates the unbounded population all at once on one plane, with the members far enough apart that they can not meet within the maximum number of steps, off by default
+        // Note: the sparse simulation already skips the empty plane around a lone member, so packing mostly trades the cost of resetting it for a larger, less cache friendly chunk map
+        // Note: members on the torus wrap around into themselves, so they can not be packed without changing their fitness
+        void setPacking(bool packing);
+        // Trims the rows and columns of the organism that are all off before placing it in the center, off by default
+        // Keeps the light cone as small as possible, the fitness functions other than center of mass on the torus do not depend on where the organism is placed
+        void setAutoCrop(bool autoCrop);
+        // Runs the final step fitness and the animations through the engine, which must have a rows x cols window and the same boundary
+        // Takes ownership of the engine, nullptr goes back to the built in simulation
+        // Note: the engines only run Conway's rule and the other fitness functions need every step so they keep the built in simulation
+        void setLifeEngine(LifeEngine* engine);
+        // Runs the simulations of one member at a time on the fixed size board, which must be rows x cols
+        // Takes ownership of the board, nullptr goes back to the built in simulation
+        // Note: only used on the torus with Conway's rule, the batches and the engine take priority where they apply
+        void setFixedBoard(FixedLife* fixedBoard);
+        // Keeps the trajectory of every member and re-simulates the next population only where each member differs from the closest one, off by default
+        // Pays off when members are a few mutations away from the last population, as in hill climbing or runs with a low mutation rate
+        // Note: only used on the torus with Conway's rule and at most 64 columns, and takes priority over the batches there
+        void setDifferential(bool differential);
+        // Looks up the rest of the fitness of the boards reached part way through a simulation in the table, and stores it for the boards that were not there
+        // The table is not owned and can be shared between genetic algorithms and threads, nullptr turns it off
+        // Note: only used one member at a time, so the batches are skipped while it is set and differential evaluation and packing take priority where they apply
+        // Note: not used for the lifespan fitness, which depends on every board before
+        void setTranspositionTable(TranspositionTable* transpositions);
+        // Evaluates the members on the number of threads, each simulating on boards of its own, 0 or less uses every hardware thread and 1 (the default) evaluates them one after another
+        // The fitness values are the same for any number of threads
+        // Note: members are handed out one at a time or a batch at a time, differential evaluation, packing and the engine stay on the calling thread
+        // Note: with more than one fitness thread the board of the genetic algorithm steps on one thread, the threads are spent on the members instead
+        void setFitnessThreads(int numThreads);
+        // Takes the fitness of members whose organism, or a rotation, reflection or translation of it that can not change the fitness, is in the cache, and stores the rest
+        // Members that repeat one earlier in the population are copied from it without a lookup
+        // The cache is not owned and can be shared between genetic algorithms and threads, nullptr turns it off
+        // Note: not used by differential evaluation and packing, which already share the work of similar members
+        void setFitnessCache(FitnessCache* fitnessCache);
+        // Weight of every metric in the weighted fitness, all 0 by default
+        // Note: the weighted fitness needs every metric, so it is evaluated one member at a time on the built in simulation or from the trajectories of differential evaluation
+        void setFitnessWeights(const GoLMetrics& weights);
     private:
         // Fitness function being used
         GoLFitnessFunction fitnessFunc;
+        // Weights of the metrics in the weighted fitness
+        GoLMetrics weights;
         // Maximum number of steps for the simulation
         int maxSteps;
         // Size of the organisms
         int orgRows;
         int orgCols;
+        // Edges of the simulation
+        GoLBoundary boundary;
+        // Stops the simulations early once they repeat
+        bool earlyExit;
+        // Evaluates the population in batches
+        bool batching;
+        // Engine used instead of the built in simulation where possible, nullptr if none
+        LifeEngine* engine;
+        // Trims the organisms before placing them
+        bool autoCrop;
+        // Evaluates the unbounded population on one plane
+        bool packing;
+        // Re-simulates members from the trajectories of the last evaluation
+        bool differential;
+        // Trajectories of the members of the last evaluation
+        vector<LifeTrajectory> trajectories;
+        // Table of the rest of the fitness from boards already seen, nullptr if none
+        TranspositionTable* transpositions;
+        // Cache of the fitness of organisms already evaluated, nullptr if none
+        FitnessCache* fitnessCache;
+        // Simulation of the calling thread, which owns the fixed size board
+        GoLSimulation simulation;
+        // Workers evaluating the members in parallel, nullptr to evaluate them one after another
+        ThreadPool* fitnessPool;
+        // Simulations of the workers other than the calling thread, rebuilt from the calling thread's when its settings change
+        vector<GoLSimulation*> workers;
+        // Whether the fixed size boards of the workers still match the calling thread's
+        bool workersValid;
 
         //---------- PRIVATE UTILITIES ----------
+        // Returns the organism of the member as it is placed, trimmed if auto crop is on, along with its size
+        char* placedMember(GoLSimulation& sim, int member, int& placedRows, int& placedCols);
+        // Clears the simulation and adds the member in the center of the rows x cols window
+        void simReset(GoLSimulation& sim, int member);
+        // Steps the simulation, returning the number of tiles changed
+        long long simStep(GoLSimulation& sim);
+        // Number of tiles on in the simulation
+        long long simPopulation(GoLSimulation& sim);
+        // Center of mass of the tiles that are on, returns false if there are none
+        bool simCenterOfMass(GoLSimulation& sim, double& x, double& y);
+        // Hash of the simulation
+        uint64_t simHash(GoLSimulation& sim);
+        // Calculates the fitness of the member with the fitness function on the simulation
+        double fitnessOf(GoLSimulation& sim, int member);
+        // Simulation of the worker of the fitness pool, worker 0 is the calling thread
+        GoLSimulation& workerSimulation(int worker);
+        // Makes a simulation for every worker other than the calling thread with the same settings as the calling thread's, keeping the ones that already have them
+        void prepareWorkers();
+        // Deletes the simulations of the workers
+        void clearWorkers();
+        // Key of the member in the fitness cache, the same for every image of its organism under the symmetries the fitness can not tell apart
+        uint64_t cacheKey(int member);
+        // Looks up every member in the fitness cache, returning the members that have to be simulated, every member if there is no cache
+        // Fills in the keys of the members and, for members that repeat an earlier one that has to be simulated, the index of that member (-1 otherwise)
+        vector<int> uncachedMembers(vector<uint64_t>& keys, vector<int>& original);
+        // Stores the fitness of the simulated members in the fitness cache and copies it to the members that repeat them
+        void cacheMembers(const vector<int>& pending, const vector<uint64_t>& keys, const vector<int>& original);
+        // Key of the board in the transposition table, the hash mixed with everything else the fitness depends on
+        uint64_t transpositionKey(const GoLSimulation& sim, uint64_t hash);
+        // Looks up the rest of the fitness from the board of the simulation at the generation
+        // Adds the hash of the board to hashes if it was not in the table, returns false without looking if there is no table or no steps left
+        bool lookupRemaining(GoLSimulation& sim, int generation, vector<uint64_t>& hashes, double& value);
+        // Stores the rest of the fitness from the boards of the first generations of the simulation, given what each step added (empty if only the final board counts) and the total
+        void storeRemaining(const vector<uint64_t>& hashes, const vector<double>& steps, double total);
+        // Calculates the fitness of the lanes members, which have already been added to the batch in the same order
+        void fitnessBatch(BatchGameOfLife& batch, const int* members, int lanes);
+        // Calculates the fitness of every member with all of them packed onto the unbounded simulation
+        void fitnessPacked();
+        // Calculates the fitness of every member from its trajectory, re-simulated from the closest one already known
+        void fitnessDifferential();
+        // Measures every metric of a member from its trajectory with the same steps as the fitness functions
+        // Note: the lifespan is only known for a trajectory that stopped at its cycle
+        GoLMetrics metricsTrajectory(const LifeTrajectory& trajectory);
+        // Measures every metric of the member on the simulation in a single pass
+        GoLMetrics metricsOf(GoLSimulation& sim, int member);
         // Calculates a fitness value for a member based on having the most tiles on at the final time step
-        double fitnessMostTiles(int member);
+        double fitnessMostTiles(GoLSimulation& sim, int member);
         // Calculates a fitness value for a member based on having the largest average in tiles over the simulation
-        double fitnessAverageChangeTiles(int member);
+        double fitnessAverageChangeTiles(GoLSimulation& sim, int member);
         // Calculates a fitness value for a member based on having the most motion of it's center of mass
-        double fitnessCenterOfMassMotion(int member);
+        double fitnessCenterOfMassMotion(GoLSimulation& sim, int member);
+        // Calculates a fitness value for a member based on the number of generations before it dies out or repeats
+        double fitnessLifespan(GoLSimulation& sim, int member);
 };
 
 //---------- EXTERNAL FUNCTIONS ----------
+// Measures the organism placed in the center of the rows x cols torus with Conway's rule by stepping a plain board one cell at a time, every step without stopping early
+// The reference the tests hold the fitness functions to, it shares none of the simulations of the genetic algorithm
+GoLMetrics referenceMetrics(int rows, int cols, int orgRows, int orgCols, const char* organism, int maxSteps);
+// Replaces the first members of the population with organisms whose cells are each on with the chance
+// Sparse organisms die out or break up within a few steps, which the random members of the tests hardly ever do
+void sparseMembers(GameOfLifeGA& ga, int numMembers, double chance);
 void test_GameOfLife();
+void test_activeTiles();
+void test_parallelStep();
+void test_stepMany();
+void test_lookupTable();
+void test_earlyExit();
+void test_statistics();
+void test_lightCone();
+void test_packing();
+void test_parallelFitness();
+void test_metrics();
+void test_steadyState();
 
 #endif
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <iostream>
 //--END DEBUG--
 #include <fstream>
+#include <mutex>
+#include <vector>
 
 #include "geneticsolver.h"
 #include "rng.h"
@@ -275,83 +277,15 @@ void GeneticAlgorithm::evalFitness(){
 }
 
 void GeneticAlgorithm::breed(){
-    //---------- DECLARATIONS ----------
-    // Index of parent 1
-    int indexParent1;
-    // Index of parent 2
-    int indexParent2;
-    // Real number roll
-    double roll;
-    // Fitness value to track which parent should be selected
-    double currFitness;
-    // The crossover points
-    int crossoverPoints[crossovers];
-    // The current crossover point
-    int currCrossoverPoint;
-    // Index to track crossover
-    int index;
-    // Temporary variable for swapping the integers into the right place
-    int tempSwap;
     // Initialize the new population
     char** newPopulation = new char*[sizePopulation];
     for(int i = 0; i < sizePopulation; i++){
         newPopulation[i] = new char[sizeMembers];
     }
 
-    //---------- ALGORITHM ----------
     // Pick parents and generate the offspring
     for(int i = 0; i < sizePopulation; i++){
-        // Pick the first parent
-        roll = rng::genRandDouble(0.0, totalFitness);
-        indexParent1 = 0;
-        currFitness = fitnessVals[0];
-        while(currFitness < roll){
-            indexParent1++;
-            currFitness += fitnessVals[indexParent1];
-        }
-
-        //Pick the second parent
-        roll = rng::genRandDouble(0.0, totalFitness);
-        indexParent2 = 0;
-        currFitness = fitnessVals[0];
-        while(currFitness < roll){
-            indexParent2++;
-            currFitness += fitnessVals[indexParent2];
-        }
-
-        // Generate crossover points
-        crossoverPoints[0] = rng::genRandInt(1, sizeMembers - 1);
-        for(int j = 1; j < crossovers; j++){
-            currCrossoverPoint = rng::genRandInt(0, sizeMembers - 1);
-            for(int k = 0; k < j; k++){
-                if(currCrossoverPoint < crossoverPoints[k]){
-                    tempSwap = crossoverPoints[k];
-                    crossoverPoints[k] = currCrossoverPoint;
-                    currCrossoverPoint = tempSwap;
-                }
-            }
-            crossoverPoints[j] = currCrossoverPoint;
-        }
-
-        // Perform crossover
-        index = 0;
-        for(int j = 0; j < crossovers; j++){
-            // Copy from the first parent
-            while(index < crossoverPoints[j]){
-                newPopulation[i][index] = population[indexParent1][index];
-                index++;
-            }
-            
-            // Swap parents for crossover
-            tempSwap = indexParent2;
-            indexParent2 = indexParent1;
-            indexParent1 = tempSwap;
-        }
-        // Copy remaining actions
-        while(index < sizeMembers){
-            newPopulation[i][index] = population[indexParent1][index];
-            index++;
-        }
+        breedChild(newPopulation[i]);
     }
 
     // Pointer shuffle
@@ -378,15 +312,78 @@ void GeneticAlgorithm::mutate(){
         //---------- SMALL MEMBER ALGORITHM ----------
         // For each member, randomly mutate each character based on the mutation, choosing from the set of available actions
         for(int i = 0; i < sizePopulation; i++){
-            for(int j = 0; j < sizeMembers; j++){
-                if(rng::genRandDouble(0.0, 1.0) < mutationRate){
-                    population[i][j] = actions[rng::genRandInt(0, numActions - 1)];
+            mutateMember(population[i]);
+        }
+    }
+}
+
+void GeneticAlgorithm::trainSteadyState(int numChildren){
+    // Children are bred from evaluated members only
+    evalFitness();
+
+    // Members whose child is still being evaluated, they are neither parents nor replaced
+    vector<bool> evaluating(sizePopulation, false);
+    int started = 0;
+    mutex lock;
+    runFitnessWorkers([&](int worker){
+        // Workers that never drew a random number would all start from the same seed
+        rng::seedRNG();
+        char* child = new char[sizeMembers];
+        while(true){
+            // Breed the next child into the place of the least fit member that is not being evaluated
+            int slot = -1;
+            {
+                lock_guard<mutex> guard(lock);
+                for(int i = 0; i < sizePopulation && started < numChildren; i++){
+                    if(!evaluating[i] && (slot < 0 || fitnessVals[i] < fitnessVals[slot])){
+                        slot = i;
+                    }
+                }
+                if(slot < 0){
+                    break;
+                }
+                started++;
+
+                // Recount the total rather than keep a running one, which would drift with the rounding of every update
+                totalFitness = 0.0;
+                for(int i = 0; i < sizePopulation; i++){
+                    totalFitness += fitnessVals[i];
                 }
+                breedChild(child, &evaluating);
+                mutateMember(child);
+                setMember(slot, child);
+
+                // A member being evaluated has no fitness yet, so it adds nothing to the total and can not be picked as a parent
+                evaluating[slot] = true;
+                fitnessVals[slot] = 0.0;
+            }
+
+            // Evaluate without holding up the other workers
+            double value = workerFitness(slot, worker);
+            {
+                lock_guard<mutex> guard(lock);
+                fitnessVals[slot] = value;
+                evaluating[slot] = false;
             }
         }
+        delete[](child);
+    });
+
+    // Track the total
+    totalFitness = 0.0;
+    for(int i = 0; i < sizePopulation; i++){
+        totalFitness += fitnessVals[i];
     }
 }
 
+double GeneticAlgorithm::workerFitness(int member, int worker){
+    return fitness(member);
+}
+
+void GeneticAlgorithm::runFitnessWorkers(const function<void(int)>& task){
+    task(0);
+}
+
 int GeneticAlgorithm::getMostFit(bool calcFitness){
     // Calculate the fitness if desired
     if(calcFitness){
@@ -425,7 +422,25 @@ double GeneticAlgorithm::getAverageFitness(bool calcFitness){
     return totalFitness / ((double) sizePopulation);
 }
 
+double GeneticAlgorithm::getFitness(int member){
+    return fitnessVals[member];
+}
+
+int GeneticAlgorithm::getSizePopulation(){
+    return sizePopulation;
+}
+
+int GeneticAlgorithm::getSizeMembers(){
+    return sizeMembers;
+}
+
 //---------- MUTATORS ----------
+void GeneticAlgorithm::setMember(int member, const char* memArr){
+    for(int i = 0; i < sizeMembers; i++){
+        population[member][i] = memArr[i];
+    }
+}
+
 void GeneticAlgorithm::setCrossovers(int crossovers){
     this->crossovers = crossovers;
 }
@@ -450,6 +465,88 @@ void GeneticAlgorithm::clearPop(){
     }
 }
 
+int GeneticAlgorithm::pickParent(const vector<bool>* excluded){
+    // Spin the roulette wheel, stopping at the last member in case rounding left the fitness short of the roll
+    double roll = rng::genRandDouble(0.0, totalFitness);
+    int parent = 0;
+    double currFitness = fitnessVals[0];
+    while(parent < sizePopulation - 1 && (currFitness < roll || (excluded && (*excluded)[parent]))){
+        parent++;
+        currFitness += fitnessVals[parent];
+    }
+
+    // Stopped on an excluded last member, take the closest one before it
+    while(excluded && (*excluded)[parent] && parent > 0){
+        parent--;
+    }
+    return parent;
+}
+
+void GeneticAlgorithm::breedChild(char* child, const vector<bool>* excluded){
+    //---------- DECLARATIONS ----------
+    // Index of parent 1
+    int indexParent1;
+    // Index of parent 2
+    int indexParent2;
+    // The crossover points
+    int crossoverPoints[crossovers];
+    // The current crossover point
+    int currCrossoverPoint;
+    // Index to track crossover
+    int index;
+    // Temporary variable for swapping the integers into the right place
+    int tempSwap;
+
+    //---------- ALGORITHM ----------
+    // Pick the first parent
+    indexParent1 = pickParent(excluded);
+
+    //Pick the second parent
+    indexParent2 = pickParent(excluded);
+
+    // Generate crossover points
+    crossoverPoints[0] = rng::genRandInt(1, sizeMembers - 1);
+    for(int j = 1; j < crossovers; j++){
+        currCrossoverPoint = rng::genRandInt(0, sizeMembers - 1);
+        for(int k = 0; k < j; k++){
+            if(currCrossoverPoint < crossoverPoints[k]){
+                tempSwap = crossoverPoints[k];
+                crossoverPoints[k] = currCrossoverPoint;
+                currCrossoverPoint = tempSwap;
+            }
+        }
+        crossoverPoints[j] = currCrossoverPoint;
+    }
+
+    // Perform crossover
+    index = 0;
+    for(int j = 0; j < crossovers; j++){
+        // Copy from the first parent
+        while(index < crossoverPoints[j]){
+            child[index] = population[indexParent1][index];
+            index++;
+        }
+        
+        // Swap parents for crossover
+        tempSwap = indexParent2;
+        indexParent2 = indexParent1;
+        indexParent1 = tempSwap;
+    }
+    // Copy remaining actions
+    while(index < sizeMembers){
+        child[index] = population[indexParent1][index];
+        index++;
+    }
+}
+
+void GeneticAlgorithm::mutateMember(char* member){
+    for(int j = 0; j < sizeMembers; j++){
+        if(rng::genRandDouble(0.0, 1.0) < mutationRate){
+            member[j] = actions[rng::genRandInt(0, numActions - 1)];
+        }
+    }
+}
+
 //---------- DEBUGGING UTILITIES ----------
 void GeneticAlgorithm::printPop(char** pop){
     for(int i = 0; i < sizePopulation; i++){
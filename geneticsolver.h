@@ -1,7 +1,9 @@
 #ifndef GENETICSOLVER_H
 #define GENETICSOLVER_H
 
+#include <functional>
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -60,11 +62,22 @@ class GeneticAlgorithm{
         // Train the algorithm for the specified number of generations
         void train(int numGenerations = 1);
         // Evaluate the fitness of the population
-        void evalFitness();
+        // Note: virtual so problems that can evaluate many members at once can override it
+        virtual void evalFitness();
         // Choose parents for breeding and create a new population
         void breed();
         // Mutate the children based on the mutation rate
         void mutate();
+        // Trains without generations for the number of children after evaluating the population once
+        // Whenever a worker is free it breeds a child from the evaluated members, puts it in the place of the least fit one and evaluates it, so no worker waits for the slowest member of a generation
+        // Note: with more than one worker the order the children arrive in, and so the result, depends on the timing of the threads
+        void trainSteadyState(int numChildren);
+        // Evaluates the fitness of a member on the worker, for problems that can evaluate several members at once
+        // Note: the default ignores the worker and calls fitness()
+        virtual double workerFitness(int member, int worker);
+        // Runs task(worker) for every worker that can evaluate members at the same time and waits for all of them to finish
+        // Note: the default only runs it on the calling thread as worker 0
+        virtual void runFitnessWorkers(const function<void(int)>& task);
         // Returns the most fit member index based on the current fitness values, recalculates if desired
         int getMostFit(bool calcFitness);
 
@@ -73,8 +86,14 @@ class GeneticAlgorithm{
         char* getMember(int member);
         // Returns the average fitness - calculates the fitness if necessary
         double getAverageFitness(bool calcFitness);
+        // Returns the fitness of the member from the last evaluation
+        double getFitness(int member);
+        int getSizePopulation();
+        int getSizeMembers();
 
         //---------- MUTATORS ----------
+        // Overwrites the member with a copy of the given one, its fitness is out of date until the next evaluation
+        void setMember(int member, const char* memArr);
         void setCrossovers(int crossovers);
         void setMutationRate(double mutationRate);
         void setTotalGens(int totalGens);
@@ -103,6 +122,12 @@ class GeneticAlgorithm{
         //---------- PRIVATE UTILITIES ----------
         // Deletes the data in the population array
         void clearPop();
+        // Picks a member with a chance in proportion to its fitness, skipping the excluded members if given
+        int pickParent(const vector<bool>* excluded);
+        // Picks two parents based on the current fitness values and writes their crossover into the child, never picking the excluded members if given
+        void breedChild(char* child, const vector<bool>* excluded = nullptr);
+        // Randomly mutates each character of the member based on the mutation rate
+        void mutateMember(char* member);
 
         //---------- DEBUGGING UTILITIES ----------
         // Prints the population when called on this->population
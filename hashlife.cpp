@@ -0,0 +1,554 @@
+#include <iostream>
+
+#include "rng.h"
+#include "hashlife.h"
+#include "gameoflife.h"
+
+//---------- HELPER FUNCTIONS ----------
+// Hash of a node based on the addresses of its unique quadrants
+static inline size_t hashQuadrants(HashLifeNode* nw, HashLifeNode* ne, HashLifeNode* sw, HashLifeNode* se){
+    uint64_t hash = (uintptr_t) nw;
+    hash = hash * 0x9E3779B97F4A7C15ULL + (uintptr_t) ne;
+    hash = hash * 0x9E3779B97F4A7C15ULL + (uintptr_t) sw;
+    hash = hash * 0x9E3779B97F4A7C15ULL + (uintptr_t) se;
+    return hash ^ (hash >> 29);
+}
+
+//-------------------------------------------------------------------------------------
+//---------- HashLife -----------------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+HashLife::HashLife() : HashLife(HASHLIFE_DEFAULT_MAX_NODES) {}
+
+HashLife::HashLife(size_t maxNodes) : rows(0), cols(0), root(nullptr), deadLeaf(nullptr), aliveLeaf(nullptr), nodeCount(0), maxNodes(maxNodes), collectAt(maxNodes), peakNodes(0), generation(0) {
+    // Create the leaves
+    deadLeaf = new HashLifeNode{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0, 0, -1, false};
+    aliveLeaf = new HashLifeNode{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 1, 0, -1, false};
+    buckets.assign(1 << 12, nullptr);
+
+    // Start with an empty universe
+    root = emptyNode(HASHLIFE_MIN_LEVEL);
+}
+
+HashLife::HashLife(int rows, int cols, bool** data, size_t maxNodes) : HashLife(maxNodes) {
+    setBoard(rows, cols, data);
+}
+
+HashLife::~HashLife(){
+    clearNodes();
+    delete(deadLeaf);
+    delete(aliveLeaf);
+}
+
+//---------- UTILITIES ----------
+void HashLife::setBoard(int rows, int cols, bool** data){
+    // Start over with an empty cache
+    clearNodes();
+    collectAt = maxNodes;
+    peakNodes = 0;
+    this->rows = rows;
+    this->cols = cols;
+    generation = 0;
+
+    // Pick a universe large enough for the board with its corner at the center
+    int level = HASHLIFE_MIN_LEVEL;
+    while(((int64_t) 1 << (level - 1)) < max(rows, cols)){
+        level++;
+    }
+    int64_t half = (int64_t) 1 << (level - 1);
+    root = buildNode(level, -half, -half, rows, cols, data);
+}
+
+void HashLife::getBoardSafe(bool** data){
+    // Clear the window and fill in the cells that are on
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            data[i][j] = false;
+        }
+    }
+    int64_t half = (int64_t) 1 << (root->level - 1);
+    fillBoard(root, -half, -half, data);
+}
+
+void HashLife::advance(uint64_t generations){
+    // Jump by each power of two in the number of generations
+    for(int log = 0; generations > 0; log++){
+        if(generations & 1){
+            stepPow2(log);
+
+            // Keep the cache within its bounds between jumps
+            if(nodeCount > maxNodes){
+                garbageCollect();
+            }
+        }
+        generations >>= 1;
+    }
+}
+
+void HashLife::garbageCollect(){
+    // Clear the old marks
+    for(HashLifeNode* bucket : buckets){
+        for(HashLifeNode* node = bucket; node; node = node->next){
+            node->marked = false;
+        }
+    }
+
+    // Mark the universe, the empty nodes and the nodes of the jump in progress as in use
+    markNode(root);
+    for(HashLifeNode* node : emptyNodes){
+        markNode(node);
+    }
+    for(HashLifeNode* node : pinned){
+        markNode(node);
+    }
+
+    // Forget the results that are about to be deleted
+    for(HashLifeNode* bucket : buckets){
+        for(HashLifeNode* node = bucket; node; node = node->next){
+            if(node->marked && node->result && !node->result->marked){
+                node->result = nullptr;
+                node->resultLog = -1;
+            }
+        }
+    }
+
+    // Delete everything that is no longer in use
+    for(size_t i = 0; i < buckets.size(); i++){
+        HashLifeNode** link = &buckets[i];
+        while(*link){
+            HashLifeNode* node = *link;
+            if(node->marked){
+                link = &node->next;
+            } else {
+                *link = node->next;
+                delete(node);
+                nodeCount--;
+            }
+        }
+    }
+
+    // Collecting again before the cache doubles would free too little to be worth it
+    collectAt = max(maxNodes, 2 * nodeCount);
+}
+
+//---------- ACCESSORS ----------
+bool HashLife::getCell(int64_t row, int64_t col) const{
+    // Move to the coordinates of the root
+    int64_t half = (int64_t) 1 << (root->level - 1);
+    row += half;
+    col += half;
+    if(row < 0 || col < 0 || row >= 2 * half || col >= 2 * half){
+        return false;
+    }
+
+    // Walk down to the leaf
+    HashLifeNode* node = root;
+    while(node->level > 0 && node->population > 0){
+        half = (int64_t) 1 << (node->level - 1);
+        if(row < half){
+            node = col < half ? node->nw : node->ne;
+        } else {
+            node = col < half ? node->sw : node->se;
+        }
+        row %= half;
+        col %= half;
+    }
+    return node->population > 0;
+}
+
+uint64_t HashLife::getPopulation() const{
+    return root->population;
+}
+
+uint64_t HashLife::getGeneration() const{
+    return generation;
+}
+
+size_t HashLife::getNodeCount() const{
+    return nodeCount;
+}
+
+size_t HashLife::getPeakNodeCount() const{
+    return peakNodes;
+}
+
+size_t HashLife::getMaxNodes() const{
+    return maxNodes;
+}
+
+//---------- MUTATORS ----------
+void HashLife::setCell(int64_t row, int64_t col, bool val){
+    // Grow the universe until it contains the cell
+    int64_t half = (int64_t) 1 << (root->level - 1);
+    while(row < -half || col < -half || row >= half || col >= half){
+        expandUniverse();
+        half = (int64_t) 1 << (root->level - 1);
+    }
+    root = setCellNode(root, row + half, col + half, val);
+}
+
+void HashLife::setMaxNodes(size_t maxNodes){
+    this->maxNodes = maxNodes;
+    collectAt = maxNodes;
+}
+
+//---------- DEBUGGING UTILITIES ----------
+ostream& operator<<(ostream& os, const HashLife& obj){
+    for(int i = 0; i < obj.rows; i++){
+        for(int j = 0; j < obj.cols; j++){
+            if(obj.getCell(i, j)){
+                os << "1";
+            } else {
+                os << "0";
+            }
+        }
+        os << "\n";
+    }
+    return os;
+}
+
+//---------- PRIVATE UTILITIES ----------
+HashLifeNode* HashLife::findNode(HashLifeNode* nw, HashLifeNode* ne, HashLifeNode* sw, HashLifeNode* se){
+    // Look for an existing copy of the node
+    size_t index = hashQuadrants(nw, ne, sw, se) & (buckets.size() - 1);
+    for(HashLifeNode* node = buckets[index]; node; node = node->next){
+        if(node->nw == nw && node->ne == ne && node->sw == sw && node->se == se){
+            return node;
+        }
+    }
+
+    // Otherwise create it
+    HashLifeNode* node = new HashLifeNode{nw, ne, sw, se, nullptr, buckets[index], nw->population + ne->population + sw->population + se->population, nw->level + 1, -1, false};
+    buckets[index] = node;
+    nodeCount++;
+    peakNodes = max(peakNodes, nodeCount);
+
+    // Keep the chains short
+    if(nodeCount > buckets.size()){
+        rehash(2 * buckets.size());
+    }
+    return node;
+}
+
+HashLifeNode* HashLife::emptyNode(int level){
+    if(emptyNodes.empty()){
+        emptyNodes.push_back(deadLeaf);
+    }
+    while((int) emptyNodes.size() <= level){
+        HashLifeNode* below = emptyNodes.back();
+        emptyNodes.push_back(findNode(below, below, below, below));
+    }
+    return emptyNodes[level];
+}
+
+HashLifeNode* HashLife::centeredSubnode(HashLifeNode* node){
+    return findNode(node->nw->se, node->ne->sw, node->sw->ne, node->se->nw);
+}
+
+HashLifeNode* HashLife::successor(HashLifeNode* node, int log){
+    // Nothing happens in an empty region
+    if(node->population == 0){
+        return emptyNode(node->level - 1);
+    }
+
+    // Check for a memoized result
+    if(node->resultLog == log){
+        return node->result;
+    }
+
+    // Safe point to keep the cache within its bounds, every node the callers still need is pinned
+    size_t frame = pinned.size();
+    pin(node);
+    if(nodeCount > collectAt){
+        garbageCollect();
+    }
+
+    HashLifeNode* result;
+    if(node->level == 2){
+        result = baseSuccessor(node);
+    } else {
+        // The nine overlapping subnodes, one level down, the corners are kept by the node
+        HashLifeNode* n00 = node->nw;
+        HashLifeNode* n01 = pin(findNode(node->nw->ne, node->ne->nw, node->nw->se, node->ne->sw));
+        HashLifeNode* n02 = node->ne;
+        HashLifeNode* n10 = pin(findNode(node->nw->sw, node->nw->se, node->sw->nw, node->sw->ne));
+        HashLifeNode* n11 = pin(centeredSubnode(node));
+        HashLifeNode* n12 = pin(findNode(node->ne->sw, node->ne->se, node->se->nw, node->se->ne));
+        HashLifeNode* n20 = node->sw;
+        HashLifeNode* n21 = pin(findNode(node->sw->ne, node->se->nw, node->sw->se, node->se->sw));
+        HashLifeNode* n22 = node->se;
+
+        // At full speed both halves advance, otherwise the first half just takes the centers
+        bool fullSpeed = log == node->level - 2;
+        int halfLog = fullSpeed ? log - 1 : log;
+        HashLifeNode* r00 = pin(fullSpeed ? successor(n00, halfLog) : centeredSubnode(n00));
+        HashLifeNode* r01 = pin(fullSpeed ? successor(n01, halfLog) : centeredSubnode(n01));
+        HashLifeNode* r02 = pin(fullSpeed ? successor(n02, halfLog) : centeredSubnode(n02));
+        HashLifeNode* r10 = pin(fullSpeed ? successor(n10, halfLog) : centeredSubnode(n10));
+        HashLifeNode* r11 = pin(fullSpeed ? successor(n11, halfLog) : centeredSubnode(n11));
+        HashLifeNode* r12 = pin(fullSpeed ? successor(n12, halfLog) : centeredSubnode(n12));
+        HashLifeNode* r20 = pin(fullSpeed ? successor(n20, halfLog) : centeredSubnode(n20));
+        HashLifeNode* r21 = pin(fullSpeed ? successor(n21, halfLog) : centeredSubnode(n21));
+        HashLifeNode* r22 = pin(fullSpeed ? successor(n22, halfLog) : centeredSubnode(n22));
+
+        // Second half of the step on the four overlapping quadrants
+        HashLifeNode* q00 = pin(successor(findNode(r00, r01, r10, r11), halfLog));
+        HashLifeNode* q01 = pin(successor(findNode(r01, r02, r11, r12), halfLog));
+        HashLifeNode* q10 = pin(successor(findNode(r10, r11, r20, r21), halfLog));
+        HashLifeNode* q11 = pin(successor(findNode(r11, r12, r21, r22), halfLog));
+        result = findNode(q00, q01, q10, q11);
+    }
+    pinned.resize(frame);
+
+    // Memoize
+    node->result = result;
+    node->resultLog = log;
+    return result;
+}
+
+HashLifeNode* HashLife::baseSuccessor(HashLifeNode* node){
+    // Unpack the 4x4 cells
+    bool cells[4][4];
+    HashLifeNode* quadrants[4] = {node->nw, node->ne, node->sw, node->se};
+    for(int q = 0; q < 4; q++){
+        int row = (q / 2) * 2;
+        int col = (q % 2) * 2;
+        cells[row][col] = quadrants[q]->nw->population;
+        cells[row][col + 1] = quadrants[q]->ne->population;
+        cells[row + 1][col] = quadrants[q]->sw->population;
+        cells[row + 1][col + 1] = quadrants[q]->se->population;
+    }
+
+    // Apply the rules to the center 2x2 cells
+    HashLifeNode* next[4];
+    for(int i = 1; i <= 2; i++){
+        for(int j = 1; j <= 2; j++){
+            int count = 0;
+            for(int di = -1; di <= 1; di++){
+                for(int dj = -1; dj <= 1; dj++){
+                    if(di != 0 || dj != 0){
+                        count += cells[i + di][j + dj];
+                    }
+                }
+            }
+            next[(i - 1) * 2 + (j - 1)] = (count == 3 || (count == 2 && cells[i][j])) ? aliveLeaf : deadLeaf;
+        }
+    }
+    return findNode(next[0], next[1], next[2], next[3]);
+}
+
+void HashLife::expandUniverse(){
+    HashLifeNode* empty = emptyNode(root->level - 1);
+    root = findNode(
+        findNode(empty, empty, empty, root->nw),
+        findNode(empty, empty, root->ne, empty),
+        findNode(empty, root->sw, empty, empty),
+        findNode(root->se, empty, empty, empty)
+    );
+}
+
+void HashLife::shrinkUniverse(){
+    while(root->level > HASHLIFE_MIN_LEVEL && root->nw->se->population + root->ne->sw->population + root->sw->ne->population + root->se->nw->population == root->population){
+        root = centeredSubnode(root);
+    }
+}
+
+bool HashLife::rootIsPadded() const{
+    // The center sixteenth of the root - everything inside can move 2^(level - 3) cells and stay in the result
+    return root->nw->se->se->population + root->ne->sw->sw->population + root->sw->ne->ne->population + root->se->nw->nw->population == root->population;
+}
+
+void HashLife::stepPow2(int log){
+    // Make room for the pattern to grow
+    while(root->level < log + 3 || !rootIsPadded()){
+        expandUniverse();
+    }
+
+    // The result is the center of the root, so the universe stays centered on (0, 0)
+    root = successor(root, log);
+    generation += (uint64_t) 1 << log;
+    shrinkUniverse();
+}
+
+HashLifeNode* HashLife::buildNode(int level, int64_t row, int64_t col, int dataRows, int dataCols, bool** data){
+    // Regions outside of the board are empty
+    int64_t size = (int64_t) 1 << level;
+    if(row + size <= 0 || col + size <= 0 || row >= dataRows || col >= dataCols){
+        return emptyNode(level);
+    }
+    if(level == 0){
+        return data[row][col] ? aliveLeaf : deadLeaf;
+    }
+
+    int64_t half = size / 2;
+    return findNode(
+        buildNode(level - 1, row, col, dataRows, dataCols, data),
+        buildNode(level - 1, row, col + half, dataRows, dataCols, data),
+        buildNode(level - 1, row + half, col, dataRows, dataCols, data),
+        buildNode(level - 1, row + half, col + half, dataRows, dataCols, data)
+    );
+}
+
+void HashLife::fillBoard(HashLifeNode* node, int64_t row, int64_t col, bool** data) const{
+    // Skip empty regions and regions outside of the window
+    int64_t size = (int64_t) 1 << node->level;
+    if(node->population == 0 || row + size <= 0 || col + size <= 0 || row >= rows || col >= cols){
+        return;
+    }
+    if(node->level == 0){
+        data[row][col] = true;
+        return;
+    }
+
+    int64_t half = size / 2;
+    fillBoard(node->nw, row, col, data);
+    fillBoard(node->ne, row, col + half, data);
+    fillBoard(node->sw, row + half, col, data);
+    fillBoard(node->se, row + half, col + half, data);
+}
+
+HashLifeNode* HashLife::setCellNode(HashLifeNode* node, int64_t row, int64_t col, bool val){
+    if(node->level == 0){
+        return val ? aliveLeaf : deadLeaf;
+    }
+
+    int64_t half = (int64_t) 1 << (node->level - 1);
+    if(row < half){
+        if(col < half){
+            return findNode(setCellNode(node->nw, row, col, val), node->ne, node->sw, node->se);
+        }
+        return findNode(node->nw, setCellNode(node->ne, row, col - half, val), node->sw, node->se);
+    }
+    if(col < half){
+        return findNode(node->nw, node->ne, setCellNode(node->sw, row - half, col, val), node->se);
+    }
+    return findNode(node->nw, node->ne, node->sw, setCellNode(node->se, row - half, col - half, val));
+}
+
+void HashLife::markNode(HashLifeNode* node){
+    if(!node || node->marked){
+        return;
+    }
+    node->marked = true;
+    if(node->level > 0){
+        markNode(node->nw);
+        markNode(node->ne);
+        markNode(node->sw);
+        markNode(node->se);
+    }
+}
+
+HashLifeNode* HashLife::pin(HashLifeNode* node){
+    pinned.push_back(node);
+    return node;
+}
+
+void HashLife::rehash(size_t numBuckets){
+    vector<HashLifeNode*> newBuckets(numBuckets, nullptr);
+    for(HashLifeNode* bucket : buckets){
+        HashLifeNode* node = bucket;
+        while(node){
+            HashLifeNode* next = node->next;
+            size_t index = hashQuadrants(node->nw, node->ne, node->sw, node->se) & (numBuckets - 1);
+            node->next = newBuckets[index];
+            newBuckets[index] = node;
+            node = next;
+        }
+    }
+    buckets.swap(newBuckets);
+}
+
+void HashLife::clearNodes(){
+    for(size_t i = 0; i < buckets.size(); i++){
+        HashLifeNode* node = buckets[i];
+        while(node){
+            HashLifeNode* next = node->next;
+            delete(node);
+            node = next;
+        }
+        buckets[i] = nullptr;
+    }
+    nodeCount = 0;
+    emptyNodes.clear();
+    root = nullptr;
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_HashLife(){
+    // A random soup in the middle of a torus large enough that nothing wraps around in time
+    int size = 200;
+    int soup = 20;
+    int jumps[] = {1, 37, 64, 100};
+
+    for(int generations : jumps){
+        GameOfLife game = GameOfLife(size, size);
+        bool** board = game.getBoard();
+        for(int i = (size - soup) / 2; i < (size + soup) / 2; i++){
+            for(int j = (size - soup) / 2; j < (size + soup) / 2; j++){
+                board[i][j] = rng::genRandDouble(0.0, 1.0) < 0.4;
+            }
+        }
+        game.invalidateTiles();
+
+        // Jump ahead with HashLife and step the regular board forward
+        HashLife hashLife = HashLife(size, size, board);
+        hashLife.advance(generations);
+        for(int k = 0; k < generations; k++){
+            game.step();
+        }
+
+        // Compare the boards
+        board = game.getBoard();
+        bool passed = hashLife.getGeneration() == (uint64_t) generations;
+        for(int i = 0; i < size && passed; i++){
+            for(int j = 0; j < size && passed; j++){
+                passed = board[i][j] == hashLife.getCell(i, j);
+            }
+        }
+        cout << "HashLife " << generations << " generations: " << (passed ? "PASSED" : "FAILED") << "\n";
+    }
+
+    // Jump a glider far ahead with a tiny cache so garbage collection has to run
+    bool glider[] = {
+        0, 1, 0,
+        0, 0, 1,
+        1, 1, 1
+    };
+    bool* gliderRows[] = {glider, glider + 3, glider + 6};
+    HashLife hashLife = HashLife(3, 3, gliderRows, 1000);
+    uint64_t generations = 1000000;
+    hashLife.advance(generations);
+
+    // A glider moves one cell diagonally every 4 generations
+    int64_t shift = generations / 4;
+    bool passed = hashLife.getPopulation() == 5 && hashLife.getNodeCount() <= 1000;
+    for(int i = 0; i < 3 && passed; i++){
+        for(int j = 0; j < 3 && passed; j++){
+            passed = hashLife.getCell(i + shift, j + shift) == glider[i * 3 + j];
+        }
+    }
+    cout << "HashLife glider " << generations << " generations: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // A single long jump of a random soup should stay close to the bound instead of growing until the jump ends, and still match an unbounded cache
+    const int soupSize = 32;
+    bool soupCells[soupSize * soupSize];
+    bool* soupRows[soupSize];
+    for(int i = 0; i < soupSize; i++){
+        soupRows[i] = soupCells + i * soupSize;
+        for(int j = 0; j < soupSize; j++){
+            soupRows[i][j] = rng::genRandDouble(0.0, 1.0) < 0.4;
+        }
+    }
+    HashLife unbounded = HashLife(soupSize, soupSize, soupRows, SIZE_MAX);
+    HashLife bounded = HashLife(soupSize, soupSize, soupRows, 20000);
+    unbounded.advance(1 << 12);
+    bounded.advance(1 << 12);
+    passed = bounded.getPopulation() == unbounded.getPopulation();
+    passed = passed && (unbounded.getPeakNodeCount() <= bounded.getMaxNodes() || bounded.getPeakNodeCount() < unbounded.getPeakNodeCount());
+    for(int64_t i = -600; i < 600 && passed; i++){
+        for(int64_t j = -600; j < 600 && passed; j++){
+            passed = bounded.getCell(i, j) == unbounded.getCell(i, j);
+        }
+    }
+    cout << "HashLife bounded jump: " << (passed ? "PASSED" : "FAILED") << ", peak " << bounded.getPeakNodeCount() << " nodes with a bound of " << bounded.getMaxNodes() << ", " << unbounded.getPeakNodeCount() << " unbounded\n";
+}
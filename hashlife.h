@@ -0,0 +1,149 @@
+#ifndef HASHLIFE_H
+#define HASHLIFE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+/*
+HashLife
+
+Gosper's HashLife algorithm for jumping a Game of Life board far into the future. The board is stored as a quadtree where every node is hash-consed, so identical regions of the board share a single node no matter where or when they appear. Each node memoizes its result - the center half of the node advanced 2^j generations - which lets repeated structure in space and time be computed once.
+
+Unlike the GameOfLife class the universe is an unbounded plane, there is no wrap around. A board loaded with setBoard() has its top left corner at (0, 0) and getBoardSafe() reads back the same rows x cols window, anything that leaves the window is still simulated but not returned.
+
+The node cache is bounded: once it grows past the maximum number of nodes, the nodes that are no longer reachable from the current board or from a jump in progress are garbage collected, along with the memoized results that point at them. The check also runs inside a jump, so a single long jump on a chaotic pattern can not run away with memory. When even the reachable nodes do not fit, the next collection waits until the cache has doubled, so the bound gives way to the working set instead of collecting over and over.
+*/
+
+//---------- CONSTANTS ----------
+// Default cap on the number of nodes in the cache
+const size_t HASHLIFE_DEFAULT_MAX_NODES = 1 << 21;
+// Smallest level of the root node - a 2^3 x 2^3 square
+const int HASHLIFE_MIN_LEVEL = 3;
+
+// A square of 2^level x 2^level cells
+struct HashLifeNode {
+    // Quadrants of the node, all nullptr for the single cell leaves
+    HashLifeNode* nw;
+    HashLifeNode* ne;
+    HashLifeNode* sw;
+    HashLifeNode* se;
+    // Memoized center of the node advanced 2^resultLog generations
+    HashLifeNode* result;
+    // Next node in the same hash bucket
+    HashLifeNode* next;
+    // Number of cells on in the node
+    uint64_t population;
+    // Size of the node as a power of two
+    int level;
+    // Log base 2 of the generations in the result, -1 if there is no result yet
+    int resultLog;
+    // Garbage collection mark
+    bool marked;
+};
+
+class HashLife{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        HashLife();
+        HashLife(size_t maxNodes);
+        HashLife(int rows, int cols, bool** data, size_t maxNodes = HASHLIFE_DEFAULT_MAX_NODES);
+        // The node cache is shared by every node so copying is not supported
+        HashLife(const HashLife & other) = delete;
+        HashLife& operator=(const HashLife & other) = delete;
+        ~HashLife();
+
+        //---------- UTILITIES ----------
+        // Replaces the universe with the board, placing its top left corner at (0, 0)
+        void setBoard(int rows, int cols, bool** data);
+        // Creates a copy of the rows x cols window at (0, 0) overwriting the data
+        void getBoardSafe(bool** data);
+        // Advances the universe the number of generations, in jumps of powers of two
+        void advance(uint64_t generations);
+        // Collects the nodes that are not part of the current universe or a jump in progress and clears the memoized results that point at them
+        void garbageCollect();
+
+        //---------- ACCESSORS ----------
+        bool getCell(int64_t row, int64_t col) const;
+        uint64_t getPopulation() const;
+        uint64_t getGeneration() const;
+        size_t getNodeCount() const;
+        // Largest number of nodes in the cache at once since the board was set
+        size_t getPeakNodeCount() const;
+        size_t getMaxNodes() const;
+
+        //---------- MUTATORS ----------
+        void setCell(int64_t row, int64_t col, bool val);
+        void setMaxNodes(size_t maxNodes);
+
+        //---------- DEBUGGING UTILITIES ----------
+        // Prints out the rows x cols window as 0s and 1s to an ostream
+        friend ostream& operator<<(ostream& os, const HashLife& obj);
+    private:
+        // Size of the window used by setBoard() and getBoardSafe()
+        int rows;
+        int cols;
+        // The universe, centered on (0, 0)
+        HashLifeNode* root;
+        // The single cell leaves
+        HashLifeNode* deadLeaf;
+        HashLifeNode* aliveLeaf;
+        // The empty node of every level
+        vector<HashLifeNode*> emptyNodes;
+        // Hash table of every node above the leaves
+        vector<HashLifeNode*> buckets;
+        // Number of nodes in the hash table
+        size_t nodeCount;
+        // Number of nodes allowed before garbage collecting
+        size_t maxNodes;
+        // Number of nodes the next garbage collection waits for, the maximum unless the reachable nodes did not fit
+        size_t collectAt;
+        // Largest number of nodes since the board was set
+        size_t peakNodes;
+        // Nodes the jump in progress still needs, kept by garbage collection
+        vector<HashLifeNode*> pinned;
+        // Number of generations simulated since the board was set
+        uint64_t generation;
+
+        //---------- PRIVATE UTILITIES ----------
+        // Returns the unique node with the given quadrants
+        HashLifeNode* findNode(HashLifeNode* nw, HashLifeNode* ne, HashLifeNode* sw, HashLifeNode* se);
+        // Returns the unique empty node of the level
+        HashLifeNode* emptyNode(int level);
+        // Returns the center of the node, one level down
+        HashLifeNode* centeredSubnode(HashLifeNode* node);
+        // Returns the center of the node advanced 2^log generations, one level down
+        HashLifeNode* successor(HashLifeNode* node, int log);
+        // Brute force successor of a 4x4 node
+        HashLifeNode* baseSuccessor(HashLifeNode* node);
+        // Doubles the size of the universe keeping it centered
+        void expandUniverse();
+        // Halves the size of the universe while the pattern still fits
+        void shrinkUniverse();
+        // Checks if every cell that is on lies in the center sixteenth of the root
+        bool rootIsPadded() const;
+        // Advances the universe 2^log generations
+        void stepPow2(int log);
+        // Builds the node covering the square at (row, col) from the board
+        HashLifeNode* buildNode(int level, int64_t row, int64_t col, int dataRows, int dataCols, bool** data);
+        // Copies the cells of the node at (row, col) into the rows x cols window
+        void fillBoard(HashLifeNode* node, int64_t row, int64_t col, bool** data) const;
+        // Returns the node with a single cell changed
+        HashLifeNode* setCellNode(HashLifeNode* node, int64_t row, int64_t col, bool val);
+        // Marks the node and everything under it as in use
+        void markNode(HashLifeNode* node);
+        // Keeps the node through garbage collection until the jump in progress unpins it
+        HashLifeNode* pin(HashLifeNode* node);
+        // Grows the hash table and redistributes the nodes
+        void rehash(size_t numBuckets);
+        // Deletes every node
+        void clearNodes();
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_HashLife();
+
+#endif
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "islandmodel.h"
+#include "gameoflife.h"
+#include "cellularautomata.h"
+
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+IslandModel::IslandModel(int numThreads) : pool(nullptr), migrationInterval(ISLAND_DEFAULT_MIGRATION_INTERVAL), sinceMigration(0), numMigrants(ISLAND_DEFAULT_MIGRANTS), topology(MigrationTopology::Ring) {
+    if(numThreads != 1){
+        pool = new ThreadPool(numThreads);
+    }
+}
+
+IslandModel::~IslandModel(){
+    for(GeneticAlgorithm* island : islands){
+        delete(island);
+    }
+    islands.clear();
+    if(pool){
+        delete(pool);
+    }
+}
+
+//---------- GENETIC ALGORITHM FUNCTIONS ----------
+void IslandModel::train(int numGenerations){
+    int trained = 0;
+    while(trained < numGenerations){
+        // Every island runs on its own up to the next migration
+        int generations = min(migrationInterval - sinceMigration, numGenerations - trained);
+        forEachIsland([generations](GeneticAlgorithm& island){
+            island.train(generations);
+        });
+        trained += generations;
+        sinceMigration += generations;
+
+        if(sinceMigration >= migrationInterval){
+            migrate();
+            sinceMigration = 0;
+        }
+    }
+}
+
+void IslandModel::migrate(){
+    int numIslands = (int) islands.size();
+    if(numIslands < 2){
+        return;
+    }
+
+    // The breeding left the fitness of the last population behind
+    forEachIsland([](GeneticAlgorithm& island){
+        island.evalFitness();
+    });
+
+    // Members of every island from the most fit to the least, ties in the order of the population
+    vector<vector<int>> ranked(numIslands);
+    for(int i = 0; i < numIslands; i++){
+        GeneticAlgorithm& island = *islands[i];
+        int sizePopulation = island.getSizePopulation();
+        for(int member = 0; member < sizePopulation; member++){
+            ranked[i].push_back(member);
+        }
+        stable_sort(ranked[i].begin(), ranked[i].end(), [&island](int a, int b){
+            return island.getFitness(a) > island.getFitness(b);
+        });
+    }
+
+    // Copy every migrant out before any island is changed, so a member moves at most one island per migration
+    vector<vector<char*>> incoming(numIslands);
+    for(int i = 0; i < numIslands; i++){
+        int target = (i + 1) % numIslands;
+        if(topology == MigrationTopology::Random){
+            target = (int) (migrationStream() % (uint32_t) (numIslands - 1));
+            target = target >= i ? target + 1 : target;
+        }
+        int sent = min(numMigrants, (int) ranked[i].size());
+        for(int m = 0; m < sent; m++){
+            incoming[target].push_back(islands[i]->getMember(ranked[i][m]));
+        }
+    }
+
+    // The migrants take the places of the least fit members
+    for(int i = 0; i < numIslands; i++){
+        int received = min((int) incoming[i].size(), (int) ranked[i].size());
+        for(int m = 0; m < received; m++){
+            islands[i]->setMember(ranked[i][ranked[i].size() - 1 - m], incoming[i][m]);
+        }
+        for(char* migrant : incoming[i]){
+            delete[](migrant);
+        }
+    }
+}
+
+int IslandModel::getMostFitIsland(bool calcFitness){
+    if(calcFitness){
+        forEachIsland([](GeneticAlgorithm& island){
+            island.evalFitness();
+        });
+    }
+
+    int bestIsland = 0;
+    double bestFitness = islands[0]->getFitness(islands[0]->getMostFit(false));
+    for(int i = 1; i < (int) islands.size(); i++){
+        double fitness = islands[i]->getFitness(islands[i]->getMostFit(false));
+        if(fitness > bestFitness){
+            bestIsland = i;
+            bestFitness = fitness;
+        }
+    }
+    return bestIsland;
+}
+
+//---------- ACCESSORS ----------
+int IslandModel::getNumIslands() const{
+    return (int) islands.size();
+}
+
+GeneticAlgorithm& IslandModel::getIsland(int island){
+    return *islands[island];
+}
+
+//---------- MUTATORS ----------
+void IslandModel::setMigrationInterval(int migrationInterval){
+    this->migrationInterval = max(1, migrationInterval);
+    sinceMigration = min(sinceMigration, this->migrationInterval - 1);
+}
+
+void IslandModel::setMigrants(int numMigrants){
+    this->numMigrants = max(0, numMigrants);
+}
+
+void IslandModel::setTopology(MigrationTopology topology){
+    this->topology = topology;
+}
+
+//---------- PRIVATE UTILITIES ----------
+void IslandModel::seedIslands(){
+    streams.clear();
+    for(size_t i = 0; i < islands.size(); i++){
+        streams.push_back(mt19937(rng::generator()));
+    }
+    migrationStream.seed(rng::generator());
+    forEachIsland([](GeneticAlgorithm& island){
+        island.initPop();
+    });
+}
+
+void IslandModel::forEachIsland(const function<void(GeneticAlgorithm&)>& task){
+    auto runIsland = [this, &task](int island, int worker){
+        // Keep the thread's own stream aside while the island uses its stream, which nothing may seed again
+        mt19937 saved = rng::generator;
+        bool seeded = rng::seeded;
+        rng::generator = streams[island];
+        rng::seeded = true;
+        task(*islands[island]);
+        streams[island] = rng::generator;
+        rng::generator = saved;
+        rng::seeded = seeded;
+    };
+    if(pool){
+        pool->parallelFor((int) islands.size(), runIsland);
+    } else {
+        for(int island = 0; island < (int) islands.size(); island++){
+            runIsland(island, 0);
+        }
+    }
+}
+
+//---------- HELPER FUNCTIONS ----------
+// Returns true if the island has a member equal to the given one
+static bool hasMember(GeneticAlgorithm& island, const char* memArr){
+    bool found = false;
+    for(int member = 0; member < island.getSizePopulation() && !found; member++){
+        char* other = island.getMember(member);
+        found = equal(other, other + island.getSizeMembers(), memArr);
+        delete[](other);
+    }
+    return found;
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_IslandModel(){
+    // The islands should end up the same on any number of threads from the same seed, even with a fitness that draws random numbers
+    MajoritySolverGA majority = MajoritySolverGA(30, 1, 0.05, 10, 59, 60);
+    bool passed = true;
+    double serialTime = 0.0;
+    double parallelTime = 0.0;
+    for(int t = 0; t < 2 && passed; t++){
+        MigrationTopology topology = t == 0 ? MigrationTopology::Ring : MigrationTopology::Random;
+        rng::generator.seed(11);
+        IslandModel serial = IslandModel(majority, 4, 1);
+        serial.setMigrationInterval(3);
+        serial.setTopology(topology);
+        rng::generator.seed(11);
+        IslandModel parallel = IslandModel(majority, 4, 4);
+        parallel.setMigrationInterval(3);
+        parallel.setTopology(topology);
+
+        auto start = chrono::steady_clock::now();
+        serial.train(4);
+        serial.train(4);
+        auto middle = chrono::steady_clock::now();
+        parallel.train(8);
+        auto end = chrono::steady_clock::now();
+        serialTime += chrono::duration<double>(middle - start).count();
+        parallelTime += chrono::duration<double>(end - middle).count();
+
+        for(int i = 0; i < 4 && passed; i++){
+            GeneticAlgorithm& a = serial.getIsland(i);
+            GeneticAlgorithm& b = parallel.getIsland(i);
+            for(int member = 0; member < a.getSizePopulation() && passed; member++){
+                char* memArr = a.getMember(member);
+                char* other = b.getMember(member);
+                passed = equal(memArr, memArr + a.getSizeMembers(), other) && a.getFitness(member) == b.getFitness(member);
+                delete[](memArr);
+                delete[](other);
+            }
+        }
+        passed = passed && serial.getMostFitIsland(false) == parallel.getMostFitIsland(false);
+    }
+    cout << "Island model threads: " << (passed ? "PASSED" : "FAILED") << ", 1 thread " << serialTime << "s, 4 threads " << parallelTime << "s on " << thread::hardware_concurrency() << " hardware threads\n";
+
+    // The most fit members of every island should land on the island they are sent to, and the islands should start out different
+    char actions[] = {0, 1};
+    GameOfLifeGA life = GameOfLifeGA(30, 8 * 8, 2, actions, 1, 0.005, 1, 20, 20, GoLFitnessFunction::FinalStepTiles, 60, 8, 8);
+    for(int t = 0; t < 2; t++){
+        IslandModel model = IslandModel(life, 4);
+        model.setMigrants(1);
+        model.setTopology(t == 0 ? MigrationTopology::Ring : MigrationTopology::Random);
+        model.train(2);
+        char* best[4];
+        for(int i = 0; i < 4; i++){
+            GeneticAlgorithm& island = model.getIsland(i);
+            best[i] = island.getMember(island.getMostFit(true));
+        }
+        passed = !hasMember(model.getIsland(1), best[0]);
+        model.migrate();
+        for(int i = 0; i < 4; i++){
+            if(t == 0){
+                passed = passed && hasMember(model.getIsland((i + 1) % 4), best[i]);
+            } else {
+                bool landed = false;
+                for(int other = 0; other < 4; other++){
+                    landed = landed || (other != i && hasMember(model.getIsland(other), best[i]));
+                }
+                passed = passed && landed;
+            }
+            delete[](best[i]);
+        }
+        cout << "Island model " << (t == 0 ? "ring" : "random") << " migration: " << (passed ? "PASSED" : "FAILED") << "\n";
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef ISLAND_MODEL_H
+#define ISLAND_MODEL_H
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "geneticsolver.h"
+#include "threadpool.h"
+#include "rng.h"
+
+using namespace std;
+
+/*
+Island Model
+
+Runs several copies of a genetic algorithm side by side, each breeding a population of its own on its own thread, and every few generations sends copies of the best members of every island to another. Islands only wait for each other at the migrations, instead of at every evaluation and breeding of one large population, and separate populations keep more of the diversity a long run would otherwise breed out.
+
+Every island has a random stream of its own that is swapped into the thread running it, and the migrations have another, so the results only depend on the seed of the calling thread when the model is made and not on how many threads there are or which thread runs which island.
+*/
+
+//---------- CONSTANTS ----------
+// Generations between migrations unless set
+const int ISLAND_DEFAULT_MIGRATION_INTERVAL = 5;
+// Members sent by every island at a migration unless set
+const int ISLAND_DEFAULT_MIGRANTS = 2;
+
+// Where the migrants of every island go
+enum class MigrationTopology {
+    // Island i sends to island i + 1, the last to the first
+    Ring,
+    // Every island sends to another island picked at random at every migration
+    Random
+};
+
+class IslandModel{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        // Creates the number of islands as copies of the genetic algorithm, every one starting from a new random population
+        // Runs them on the number of threads, including the calling thread - 0 or less uses every hardware thread and 1 runs them one after another
+        template<class GA>
+        IslandModel(const GA& prototype, int numIslands, int numThreads = 0);
+        // Islands and threads can not be copied
+        IslandModel(const IslandModel & other) = delete;
+        IslandModel& operator=(const IslandModel & other) = delete;
+        ~IslandModel();
+
+        //---------- GENETIC ALGORITHM FUNCTIONS ----------
+        // Trains every island for the number of generations, migrating every time the migration interval is reached
+        // Note: an island re-evaluates its whole population after a migration, the interval spreads that cost over its generations
+        void train(int numGenerations = 1);
+        // Evaluates every island and replaces its least fit members with copies of the most fit members of the islands sending to it
+        void migrate();
+        // Returns the island with the most fit member based on the current fitness values, recalculates if desired
+        int getMostFitIsland(bool calcFitness);
+
+        //---------- ACCESSORS ----------
+        int getNumIslands() const;
+        GeneticAlgorithm& getIsland(int island);
+
+        //---------- MUTATORS ----------
+        void setMigrationInterval(int migrationInterval);
+        void setMigrants(int numMigrants);
+        void setTopology(MigrationTopology topology);
+    private:
+        // The islands, owned
+        vector<GeneticAlgorithm*> islands;
+        // Random stream of every island
+        vector<mt19937> streams;
+        // Random stream picking the islands the migrants go to
+        mt19937 migrationStream;
+        // Threads running the islands, nullptr to run them one after another
+        ThreadPool* pool;
+        // Generations between migrations
+        int migrationInterval;
+        // Generations trained since the last migration
+        int sinceMigration;
+        // Members sent by every island at a migration
+        int numMigrants;
+        // Where the migrants go
+        MigrationTopology topology;
+
+        //---------- PRIVATE UTILITIES ----------
+        // Creates the model without islands
+        IslandModel(int numThreads);
+        // Gives every island and the migrations a stream seeded from the calling thread, and every island a new random population
+        void seedIslands();
+        // Runs the task on every island in parallel, each with its own random stream
+        void forEachIsland(const function<void(GeneticAlgorithm&)>& task);
+};
+
+//---------- TEMPLATE FUNCTIONS ----------
+template<class GA>
+IslandModel::IslandModel(const GA& prototype, int numIslands, int numThreads) : IslandModel(numThreads) {
+    for(int i = 0; i < numIslands; i++){
+        islands.push_back(new GA(prototype));
+    }
+    seedIslands();
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_IslandModel();
+
+#endif
@@ -0,0 +1,495 @@
+#include <iostream>
+
+#include "kernels.h"
+#include "rng.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KERNELS_X86
+#include <immintrin.h>
+#endif
+
+//-------------------------------------------------------------------------------------
+//---------- SCALAR KERNELS -----------------------------------------------------------
+//-------------------------------------------------------------------------------------
+// The scalar kernels are both the fallback and the reference for the vectorized kernels
+// The vectorized kernels also use them to finish off the cells that don't fill out a vector
+static int lifeRowScalar(const bool* up, const bool* mid, const bool* down, bool* next, int n){
+    // Count of neighbors
+    int count;
+    // Count of the changed cells
+    int changes = 0;
+    for(int j = 0; j < n; j++){
+        count = up[j - 1] + up[j] + up[j + 1] + mid[j - 1] + mid[j + 1] + down[j - 1] + down[j] + down[j + 1];
+        next[j] = count == 3 || (count == 2 && mid[j]);
+        changes += next[j] != mid[j];
+    }
+    return changes;
+}
+
+static int countDiffScalar(const bool* a, const bool* b, int n){
+    int count = 0;
+    for(int j = 0; j < n; j++){
+        count += a[j] != b[j];
+    }
+    return count;
+}
+
+static int countTrueScalar(const bool* a, int n){
+    int count = 0;
+    for(int j = 0; j < n; j++){
+        count += a[j];
+    }
+    return count;
+}
+
+static void ca1DRowScalar(const bool* curr, bool* next, int n, const bool* table){
+    for(int j = 0; j < n; j++){
+        next[j] = table[curr[j - 1] * 4 + curr[j] * 2 + curr[j + 1]];
+    }
+}
+
+static void ca1DGeneralRowScalar(const bool* curr, bool* next, int n, int radius, const int* table){
+    // Rule to apply for the current neighborhood of points
+    int ruleVal;
+    for(int j = 0; j < n; j++){
+        ruleVal = 0;
+        for(int k = -radius; k <= radius; k++){
+            ruleVal = ruleVal * 2 + curr[j + k];
+        }
+        next[j] = table[ruleVal];
+    }
+}
+
+#ifdef KERNELS_X86
+//-------------------------------------------------------------------------------------
+//---------- SSE2 KERNELS -------------------------------------------------------------
+//-------------------------------------------------------------------------------------
+__attribute__((target("sse2")))
+static int lifeRowSSE2(const bool* up, const bool* mid, const bool* down, bool* next, int n){
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i two = _mm_set1_epi8(2);
+    const __m128i three = _mm_set1_epi8(3);
+    __m128i changes = _mm_setzero_si128();
+    int j = 0;
+    for(; j + 16 <= n; j += 16){
+        __m128i center = _mm_loadu_si128((const __m128i*) (mid + j));
+        __m128i count = _mm_add_epi8(_mm_loadu_si128((const __m128i*) (up + j - 1)), _mm_loadu_si128((const __m128i*) (up + j)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i*) (up + j + 1)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i*) (mid + j - 1)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i*) (mid + j + 1)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i*) (down + j - 1)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i*) (down + j)));
+        count = _mm_add_epi8(count, _mm_loadu_si128((const __m128i*) (down + j + 1)));
+
+        // Alive with 3 neighbors, or with 2 neighbors when already alive
+        __m128i alive = _mm_or_si128(_mm_cmpeq_epi8(count, three), _mm_and_si128(_mm_cmpeq_epi8(count, two), _mm_cmpeq_epi8(center, one)));
+        __m128i result = _mm_and_si128(alive, one);
+        _mm_storeu_si128((__m128i*) (next + j), result);
+        changes = _mm_add_epi64(changes, _mm_sad_epu8(_mm_xor_si128(result, center), _mm_setzero_si128()));
+    }
+    return _mm_cvtsi128_si32(changes) + _mm_cvtsi128_si32(_mm_srli_si128(changes, 8)) + lifeRowScalar(up + j, mid + j, down + j, next + j, n - j);
+}
+
+__attribute__((target("sse2")))
+static int countDiffSSE2(const bool* a, const bool* b, int n){
+    __m128i sums = _mm_setzero_si128();
+    int j = 0;
+    for(; j + 16 <= n; j += 16){
+        __m128i diff = _mm_xor_si128(_mm_loadu_si128((const __m128i*) (a + j)), _mm_loadu_si128((const __m128i*) (b + j)));
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(diff, _mm_setzero_si128()));
+    }
+    return _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8)) + countDiffScalar(a + j, b + j, n - j);
+}
+
+__attribute__((target("sse2")))
+static int countTrueSSE2(const bool* a, int n){
+    __m128i sums = _mm_setzero_si128();
+    int j = 0;
+    for(; j + 16 <= n; j += 16){
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) (a + j)), _mm_setzero_si128()));
+    }
+    return _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8)) + countTrueScalar(a + j, n - j);
+}
+
+__attribute__((target("sse2")))
+static void ca1DRowSSE2(const bool* curr, bool* next, int n, const bool* table){
+    // SSE2 has no byte shuffle, so the table is applied by comparing against every rule that turns the cell on
+    const __m128i one = _mm_set1_epi8(1);
+    int j = 0;
+    for(; j + 16 <= n; j += 16){
+        __m128i index = _mm_loadu_si128((const __m128i*) (curr + j - 1));
+        index = _mm_add_epi8(index, index);
+        index = _mm_add_epi8(index, _mm_loadu_si128((const __m128i*) (curr + j)));
+        index = _mm_add_epi8(index, index);
+        index = _mm_add_epi8(index, _mm_loadu_si128((const __m128i*) (curr + j + 1)));
+
+        __m128i result = _mm_setzero_si128();
+        for(int k = 0; k < 8; k++){
+            if(table[k]){
+                result = _mm_or_si128(result, _mm_cmpeq_epi8(index, _mm_set1_epi8(k)));
+            }
+        }
+        _mm_storeu_si128((__m128i*) (next + j), _mm_and_si128(result, one));
+    }
+    ca1DRowScalar(curr + j, next + j, n - j, table);
+}
+
+__attribute__((target("sse2")))
+static void ca1DGeneralRowSSE2(const bool* curr, bool* next, int n, int radius, const int* table){
+    // The rule indices are built 8 cells at a time in 16 bit lanes, the table itself is too large for a register
+    alignas(16) unsigned short indices[8];
+    int j = 0;
+    for(; j + 8 <= n && 2 * radius + 1 <= 16; j += 8){
+        __m128i index = _mm_setzero_si128();
+        for(int k = -radius; k <= radius; k++){
+            __m128i cells = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) (curr + j + k)), _mm_setzero_si128());
+            index = _mm_or_si128(_mm_slli_epi16(index, 1), cells);
+        }
+        _mm_store_si128((__m128i*) indices, index);
+        for(int k = 0; k < 8; k++){
+            next[j + k] = table[indices[k]];
+        }
+    }
+    ca1DGeneralRowScalar(curr + j, next + j, n - j, radius, table);
+}
+
+//-------------------------------------------------------------------------------------
+//---------- AVX2 KERNELS -------------------------------------------------------------
+//-------------------------------------------------------------------------------------
+// The tails are handled by the narrower kernels, which use the legacy SSE encoding, so the upper halves of the registers are cleared first
+// Mixing the two encodings with dirty upper halves stalls every SSE instruction on many CPUs, and GCC does not clear them on its own in target attribute functions
+__attribute__((target("avx2")))
+static int lifeRowAVX2(const bool* up, const bool* mid, const bool* down, bool* next, int n){
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i two = _mm256_set1_epi8(2);
+    const __m256i three = _mm256_set1_epi8(3);
+    __m256i changes = _mm256_setzero_si256();
+    int j = 0;
+    for(; j + 32 <= n; j += 32){
+        __m256i center = _mm256_loadu_si256((const __m256i*) (mid + j));
+        __m256i count = _mm256_add_epi8(_mm256_loadu_si256((const __m256i*) (up + j - 1)), _mm256_loadu_si256((const __m256i*) (up + j)));
+        count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i*) (up + j + 1)));
+        count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i*) (mid + j - 1)));
+        count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i*) (mid + j + 1)));
+        count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i*) (down + j - 1)));
+        count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i*) (down + j)));
+        count = _mm256_add_epi8(count, _mm256_loadu_si256((const __m256i*) (down + j + 1)));
+
+        // Alive with 3 neighbors, or with 2 neighbors when already alive
+        __m256i alive = _mm256_or_si256(_mm256_cmpeq_epi8(count, three), _mm256_and_si256(_mm256_cmpeq_epi8(count, two), _mm256_cmpeq_epi8(center, one)));
+        __m256i result = _mm256_and_si256(alive, one);
+        _mm256_storeu_si256((__m256i*) (next + j), result);
+        changes = _mm256_add_epi64(changes, _mm256_sad_epu8(_mm256_xor_si256(result, center), _mm256_setzero_si256()));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256((__m256i*) lanes, changes);
+    _mm256_zeroupper();
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lifeRowSSE2(up + j, mid + j, down + j, next + j, n - j);
+}
+
+__attribute__((target("avx2")))
+static int countDiffAVX2(const bool* a, const bool* b, int n){
+    __m256i sums = _mm256_setzero_si256();
+    int j = 0;
+    for(; j + 32 <= n; j += 32){
+        __m256i diff = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) (a + j)), _mm256_loadu_si256((const __m256i*) (b + j)));
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(diff, _mm256_setzero_si256()));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256((__m256i*) lanes, sums);
+    _mm256_zeroupper();
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + countDiffSSE2(a + j, b + j, n - j);
+}
+
+__attribute__((target("avx2")))
+static int countTrueAVX2(const bool* a, int n){
+    __m256i sums = _mm256_setzero_si256();
+    int j = 0;
+    for(; j + 32 <= n; j += 32){
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i*) (a + j)), _mm256_setzero_si256()));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256((__m256i*) lanes, sums);
+    _mm256_zeroupper();
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + countTrueSSE2(a + j, n - j);
+}
+
+__attribute__((target("avx2")))
+static void ca1DRowAVX2(const bool* curr, bool* next, int n, const bool* table){
+    // The 8 entry table fits in a single shuffle, repeated in both 128 bit lanes
+    alignas(32) char lookup[32];
+    for(int k = 0; k < 32; k++){
+        lookup[k] = k % 16 < 8 ? table[k % 16] : 0;
+    }
+    const __m256i tableVec = _mm256_load_si256((const __m256i*) lookup);
+    int j = 0;
+    for(; j + 32 <= n; j += 32){
+        __m256i index = _mm256_loadu_si256((const __m256i*) (curr + j - 1));
+        index = _mm256_add_epi8(index, index);
+        index = _mm256_add_epi8(index, _mm256_loadu_si256((const __m256i*) (curr + j)));
+        index = _mm256_add_epi8(index, index);
+        index = _mm256_add_epi8(index, _mm256_loadu_si256((const __m256i*) (curr + j + 1)));
+        _mm256_storeu_si256((__m256i*) (next + j), _mm256_shuffle_epi8(tableVec, index));
+    }
+    _mm256_zeroupper();
+    ca1DRowSSE2(curr + j, next + j, n - j, table);
+}
+
+__attribute__((target("avx2")))
+static void ca1DGeneralRowAVX2(const bool* curr, bool* next, int n, int radius, const int* table){
+    // Rule indices are built 8 cells at a time in 32 bit lanes and looked up with a gather
+    alignas(32) int results[8];
+    int j = 0;
+    for(; j + 8 <= n; j += 8){
+        __m256i index = _mm256_setzero_si256();
+        for(int k = -radius; k <= radius; k++){
+            __m256i cells = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) (curr + j + k)));
+            index = _mm256_or_si256(_mm256_slli_epi32(index, 1), cells);
+        }
+        _mm256_store_si256((__m256i*) results, _mm256_i32gather_epi32(table, index, 4));
+        for(int k = 0; k < 8; k++){
+            next[j + k] = results[k];
+        }
+    }
+    _mm256_zeroupper();
+    ca1DGeneralRowScalar(curr + j, next + j, n - j, radius, table);
+}
+
+//-------------------------------------------------------------------------------------
+//---------- AVX-512 KERNELS ----------------------------------------------------------
+//-------------------------------------------------------------------------------------
+// GCC flags the deliberately undefined registers inside its own AVX-512 headers
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+__attribute__((target("avx512f,avx512bw")))
+static int lifeRowAVX512(const bool* up, const bool* mid, const bool* down, bool* next, int n){
+    const __m512i one = _mm512_set1_epi8(1);
+    const __m512i two = _mm512_set1_epi8(2);
+    const __m512i three = _mm512_set1_epi8(3);
+    __m512i changes = _mm512_setzero_si512();
+    int j = 0;
+    for(; j + 64 <= n; j += 64){
+        __m512i center = _mm512_loadu_si512((const void*) (mid + j));
+        __m512i count = _mm512_add_epi8(_mm512_loadu_si512((const void*) (up + j - 1)), _mm512_loadu_si512((const void*) (up + j)));
+        count = _mm512_add_epi8(count, _mm512_loadu_si512((const void*) (up + j + 1)));
+        count = _mm512_add_epi8(count, _mm512_loadu_si512((const void*) (mid + j - 1)));
+        count = _mm512_add_epi8(count, _mm512_loadu_si512((const void*) (mid + j + 1)));
+        count = _mm512_add_epi8(count, _mm512_loadu_si512((const void*) (down + j - 1)));
+        count = _mm512_add_epi8(count, _mm512_loadu_si512((const void*) (down + j)));
+        count = _mm512_add_epi8(count, _mm512_loadu_si512((const void*) (down + j + 1)));
+
+        // Alive with 3 neighbors, or with 2 neighbors when already alive
+        __mmask64 alive = _mm512_cmpeq_epi8_mask(count, three) | (_mm512_cmpeq_epi8_mask(count, two) & _mm512_cmpeq_epi8_mask(center, one));
+        __m512i result = _mm512_maskz_mov_epi8(alive, one);
+        _mm512_storeu_si512((void*) (next + j), result);
+        changes = _mm512_add_epi64(changes, _mm512_sad_epu8(_mm512_xor_si512(result, center), _mm512_setzero_si512()));
+    }
+    return _mm512_reduce_add_epi64(changes) + lifeRowAVX2(up + j, mid + j, down + j, next + j, n - j);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static int countDiffAVX512(const bool* a, const bool* b, int n){
+    __m512i sums = _mm512_setzero_si512();
+    int j = 0;
+    for(; j + 64 <= n; j += 64){
+        __m512i diff = _mm512_xor_si512(_mm512_loadu_si512((const void*) (a + j)), _mm512_loadu_si512((const void*) (b + j)));
+        sums = _mm512_add_epi64(sums, _mm512_sad_epu8(diff, _mm512_setzero_si512()));
+    }
+    return _mm512_reduce_add_epi64(sums) + countDiffAVX2(a + j, b + j, n - j);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static int countTrueAVX512(const bool* a, int n){
+    __m512i sums = _mm512_setzero_si512();
+    int j = 0;
+    for(; j + 64 <= n; j += 64){
+        sums = _mm512_add_epi64(sums, _mm512_sad_epu8(_mm512_loadu_si512((const void*) (a + j)), _mm512_setzero_si512()));
+    }
+    return _mm512_reduce_add_epi64(sums) + countTrueAVX2(a + j, n - j);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void ca1DRowAVX512(const bool* curr, bool* next, int n, const bool* table){
+    // The 8 entry table fits in a single shuffle, repeated in all four 128 bit lanes
+    alignas(64) char lookup[64];
+    for(int k = 0; k < 64; k++){
+        lookup[k] = k % 16 < 8 ? table[k % 16] : 0;
+    }
+    const __m512i tableVec = _mm512_load_si512((const void*) lookup);
+    int j = 0;
+    for(; j + 64 <= n; j += 64){
+        __m512i index = _mm512_loadu_si512((const void*) (curr + j - 1));
+        index = _mm512_add_epi8(index, index);
+        index = _mm512_add_epi8(index, _mm512_loadu_si512((const void*) (curr + j)));
+        index = _mm512_add_epi8(index, index);
+        index = _mm512_add_epi8(index, _mm512_loadu_si512((const void*) (curr + j + 1)));
+        _mm512_storeu_si512((void*) (next + j), _mm512_shuffle_epi8(tableVec, index));
+    }
+    ca1DRowAVX2(curr + j, next + j, n - j, table);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void ca1DGeneralRowAVX512(const bool* curr, bool* next, int n, int radius, const int* table){
+    // Rule indices are built 16 cells at a time in 32 bit lanes and looked up with a gather
+    int j = 0;
+    for(; j + 16 <= n; j += 16){
+        __m512i index = _mm512_setzero_si512();
+        for(int k = -radius; k <= radius; k++){
+            __m512i cells = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*) (curr + j + k)));
+            index = _mm512_or_si512(_mm512_slli_epi32(index, 1), cells);
+        }
+        __m512i results = _mm512_i32gather_epi32(index, table, 4);
+        _mm_storeu_si128((__m128i*) (next + j), _mm512_cvtepi32_epi8(results));
+    }
+    ca1DGeneralRowAVX2(curr + j, next + j, n - j, radius, table);
+}
+#pragma GCC diagnostic pop
+#endif
+
+//-------------------------------------------------------------------------------------
+//---------- DISPATCH -----------------------------------------------------------------
+//-------------------------------------------------------------------------------------
+// The set of kernels for a single instruction set
+struct KernelTable {
+    kernels::ISA isa;
+    int (*lifeRow)(const bool*, const bool*, const bool*, bool*, int);
+    int (*countDiff)(const bool*, const bool*, int);
+    int (*countTrue)(const bool*, int);
+    void (*ca1DRow)(const bool*, bool*, int, const bool*);
+    void (*ca1DGeneralRow)(const bool*, bool*, int, int, const int*);
+};
+
+static KernelTable makeTable(kernels::ISA isa){
+#ifdef KERNELS_X86
+    switch(isa){
+        case kernels::ISA::AVX512:
+            return {isa, lifeRowAVX512, countDiffAVX512, countTrueAVX512, ca1DRowAVX512, ca1DGeneralRowAVX512};
+        case kernels::ISA::AVX2:
+            return {isa, lifeRowAVX2, countDiffAVX2, countTrueAVX2, ca1DRowAVX2, ca1DGeneralRowAVX2};
+        case kernels::ISA::SSE2:
+            return {isa, lifeRowSSE2, countDiffSSE2, countTrueSSE2, ca1DRowSSE2, ca1DGeneralRowSSE2};
+        default:
+            break;
+    }
+#endif
+    return {kernels::ISA::Scalar, lifeRowScalar, countDiffScalar, countTrueScalar, ca1DRowScalar, ca1DGeneralRowScalar};
+}
+
+// The kernels in use, detected the first time any kernel is called
+static KernelTable& activeTable(){
+    static KernelTable table = makeTable(kernels::detectISA());
+    return table;
+}
+
+kernels::ISA kernels::detectISA(){
+#ifdef KERNELS_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")){
+        return ISA::AVX512;
+    } else if(__builtin_cpu_supports("avx2")){
+        return ISA::AVX2;
+    } else if(__builtin_cpu_supports("sse2")){
+        return ISA::SSE2;
+    }
+#endif
+    return ISA::Scalar;
+}
+
+kernels::ISA kernels::getISA(){
+    return activeTable().isa;
+}
+
+void kernels::setISA(ISA isa){
+    ISA supported = detectISA();
+    activeTable() = makeTable(isa > supported ? supported : isa);
+}
+
+const char* kernels::isaName(ISA isa){
+    switch(isa){
+        case ISA::SSE2:
+            return "SSE2";
+        case ISA::AVX2:
+            return "AVX2";
+        case ISA::AVX512:
+            return "AVX-512";
+        default:
+            return "Scalar";
+    }
+}
+
+int kernels::lifeRow(const bool* up, const bool* mid, const bool* down, bool* next, int n){
+    return activeTable().lifeRow(up, mid, down, next, n);
+}
+
+int kernels::countDiff(const bool* a, const bool* b, int n){
+    return activeTable().countDiff(a, b, n);
+}
+
+int kernels::countTrue(const bool* a, int n){
+    return activeTable().countTrue(a, n);
+}
+
+void kernels::ca1DRow(const bool* curr, bool* next, int n, const bool* table){
+    activeTable().ca1DRow(curr, next, n, table);
+}
+
+void kernels::ca1DGeneralRow(const bool* curr, bool* next, int n, int radius, const int* table){
+    activeTable().ca1DGeneralRow(curr, next, n, radius, table);
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_kernels(){
+    // Random data with padding on both sides for the neighbors
+    const int size = 1000;
+    const int pad = 8;
+    const int radius = 3;
+    bool rows[3][size + 2 * pad];
+    for(int i = 0; i < 3; i++){
+        for(int j = 0; j < size + 2 * pad; j++){
+            rows[i][j] = rng::genRandDouble(0.0, 1.0) < 0.4;
+        }
+    }
+    bool table[8];
+    for(int k = 0; k < 8; k++){
+        table[k] = rng::genRandDouble(0.0, 1.0) < 0.5;
+    }
+    int generalTable[1 << (2 * radius + 1)];
+    for(int k = 0; k < (1 << (2 * radius + 1)); k++){
+        generalTable[k] = rng::genRandDouble(0.0, 1.0) < 0.5;
+    }
+    const bool* up = rows[0] + pad;
+    const bool* mid = rows[1] + pad;
+    const bool* down = rows[2] + pad;
+
+    // Reference results from the scalar kernels
+    bool expectedLife[size];
+    bool expectedCA[size];
+    bool expectedGeneral[size];
+    int expectedLifeChanges = lifeRowScalar(up, mid, down, expectedLife, size);
+    ca1DRowScalar(mid, expectedCA, size, table);
+    ca1DGeneralRowScalar(mid, expectedGeneral, size, radius, generalTable);
+    int expectedDiff = countDiffScalar(up, mid, size);
+    int expectedTrue = countTrueScalar(mid, size);
+
+    // Compare every supported instruction set against the reference, including lengths that leave a tail
+    kernels::ISA original = kernels::getISA();
+    bool result[size];
+    for(int isa = (int) kernels::ISA::Scalar; isa <= (int) kernels::detectISA(); isa++){
+        kernels::setISA((kernels::ISA) isa);
+        bool passed = true;
+        for(int n = size - 37; n <= size; n += 37){
+            int changes = kernels::lifeRow(up, mid, down, result, n);
+            passed = passed && countDiffScalar(result, expectedLife, n) == 0;
+            passed = passed && (n < size || changes == expectedLifeChanges);
+            kernels::ca1DRow(mid, result, n, table);
+            passed = passed && countDiffScalar(result, expectedCA, n) == 0;
+            kernels::ca1DGeneralRow(mid, result, n, radius, generalTable);
+            passed = passed && countDiffScalar(result, expectedGeneral, n) == 0;
+        }
+        passed = passed && kernels::countDiff(up, mid, size) == expectedDiff;
+        passed = passed && kernels::countTrue(mid, size) == expectedTrue;
+        std::cout << "Kernels " << kernels::isaName(kernels::getISA()) << ": " << (passed ? "PASSED" : "FAILED") << "\n";
+    }
+    kernels::setISA(original);
+}
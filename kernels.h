@@ -0,0 +1,57 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+/*
+Kernels
+
+Runtime dispatched versions of the hot loops of the simulations. The CPU features are detected once, the first time a kernel is used, and every call is routed to the widest implementation the machine supports. This lets a single build run on machines with and without the wider vector extensions.
+
+Every vectorized kernel produces results that are bit-identical to the scalar version, so the choice of instruction set never changes the simulation.
+
+Board rows are passed as bool arrays (one byte per cell holding 0 or 1). Kernels that look at neighbors read one past each end of the given range, so the caller is responsible for handling the wrap around at the edges of the domain.
+*/
+
+namespace kernels{
+    // Instruction sets with kernel implementations, ordered from narrowest to widest
+    enum class ISA {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    // Returns the widest instruction set supported by this CPU
+    ISA detectISA();
+
+    // Returns the instruction set currently used by the kernels
+    ISA getISA();
+
+    // Forces the kernels to use the given instruction set - falls back to the widest supported one if the CPU lacks it
+    void setISA(ISA isa);
+
+    // Human readable name of the instruction set
+    const char* isaName(ISA isa);
+
+    // Applies the Game of Life rules to the cells [0, n) of a row, reading the cells [-1, n] of the rows above, at and below it
+    // Returns the number of cells that changed
+    int lifeRow(const bool* up, const bool* mid, const bool* down, bool* next, int n);
+
+    // Counts the number of cells that differ between the two rows
+    int countDiff(const bool* a, const bool* b, int n);
+
+    // Counts the number of true cells in the row
+    int countTrue(const bool* a, int n);
+
+    // Applies a nearest neighbor 1D cellular automaton rule to the cells [0, n), reading the cells [-1, n]
+    // The rule table is indexed by left * 4 + center * 2 + right
+    void ca1DRow(const bool* curr, bool* next, int n, const bool* table);
+
+    // Applies a radius k 1D cellular automaton rule to the cells [0, n), reading the cells [-k, n + k - 1]
+    // The rule table is indexed with the left most neighbor as the highest bit and holds 0 or 1
+    void ca1DGeneralRow(const bool* curr, bool* next, int n, int radius, const int* table);
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_kernels();
+
+#endif
@@ -0,0 +1,414 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include "rng.h"
+#include "lifeengine.h"
+
+//-------------------------------------------------------------------------------------
+//---------- LifeEngine ---------------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+LifeEngine::LifeEngine(int rows, int cols) : rows(rows), cols(cols) {}
+
+LifeEngine::~LifeEngine(){}
+
+//---------- ACCESSORS ----------
+int LifeEngine::getRows() const{
+    return rows;
+}
+
+int LifeEngine::getCols() const{
+    return cols;
+}
+
+//-------------------------------------------------------------------------------------
+//---------- DenseLifeEngine ----------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+DenseLifeEngine::DenseLifeEngine(int rows, int cols) : LifeEngine(rows, cols), game(rows, cols) {}
+
+//---------- UTILITIES ----------
+void DenseLifeEngine::reset(int orgRows, int orgCols, char* organism){
+    game.addOrganism(orgRows, orgCols, organism);
+    game.invalidateTiles();
+}
+
+void DenseLifeEngine::setBoard(bool** data){
+    bool** board = game.getBoard();
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            board[i][j] = data[i][j];
+        }
+    }
+    game.invalidateTiles();
+}
+
+void DenseLifeEngine::getBoardSafe(bool** data){
+    game.getBoardSafe(data);
+}
+
+void DenseLifeEngine::advance(long long generations){
+    // Blocking in time only pays off once two rows of blocks no longer fit in the cache
+    if((long long) rows * cols > 4LL * GAME_OF_LIFE_TEMPORAL_BLOCK * GAME_OF_LIFE_TEMPORAL_BLOCK){
+        while(generations > 0){
+            int steps = (int) min(generations, (long long) INT_MAX);
+            game.stepMany(steps);
+            generations -= steps;
+        }
+    } else {
+        for(long long k = 0; k < generations; k++){
+            game.step();
+        }
+    }
+}
+
+//---------- ACCESSORS ----------
+long long DenseLifeEngine::getPopulation(){
+    return game.getStatistics().population;
+}
+
+LifeBackend DenseLifeEngine::getBackend() const{
+    return LifeBackend::Dense;
+}
+
+GoLBoundary DenseLifeEngine::getBoundary() const{
+    return GoLBoundary::Toroidal;
+}
+
+//-------------------------------------------------------------------------------------
+//---------- PackedLifeEngine ---------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+PackedLifeEngine::PackedLifeEngine(int rows, int cols) : LifeEngine(rows, cols), game(rows, cols) {}
+
+//---------- UTILITIES ----------
+void PackedLifeEngine::reset(int orgRows, int orgCols, char* organism){
+    game.addOrganism(orgRows, orgCols, organism);
+}
+
+void PackedLifeEngine::setBoard(bool** data){
+    game.setBoard(data);
+}
+
+void PackedLifeEngine::getBoardSafe(bool** data){
+    game.getBoardSafe(data);
+}
+
+void PackedLifeEngine::advance(long long generations){
+    for(long long k = 0; k < generations; k++){
+        game.step();
+    }
+}
+
+//---------- ACCESSORS ----------
+long long PackedLifeEngine::getPopulation(){
+    return game.getPopulation();
+}
+
+LifeBackend PackedLifeEngine::getBackend() const{
+    return LifeBackend::Packed;
+}
+
+GoLBoundary PackedLifeEngine::getBoundary() const{
+    return GoLBoundary::Toroidal;
+}
+
+//-------------------------------------------------------------------------------------
+//---------- SparseLifeEngine ---------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+SparseLifeEngine::SparseLifeEngine(int rows, int cols) : LifeEngine(rows, cols), game() {}
+
+//---------- UTILITIES ----------
+void SparseLifeEngine::reset(int orgRows, int orgCols, char* organism){
+    game.clear();
+    game.addOrganism((rows - orgRows) / 2, (cols - orgCols) / 2, orgRows, orgCols, organism);
+}
+
+void SparseLifeEngine::setBoard(bool** data){
+    game.clear();
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            if(data[i][j]){
+                game.setCell(i, j, true);
+            }
+        }
+    }
+}
+
+void SparseLifeEngine::getBoardSafe(bool** data){
+    game.getWindow(0, 0, rows, cols, data);
+}
+
+void SparseLifeEngine::advance(long long generations){
+    for(long long k = 0; k < generations; k++){
+        game.step();
+    }
+}
+
+//---------- ACCESSORS ----------
+long long SparseLifeEngine::getPopulation(){
+    return game.getPopulation();
+}
+
+LifeBackend SparseLifeEngine::getBackend() const{
+    return LifeBackend::Sparse;
+}
+
+GoLBoundary SparseLifeEngine::getBoundary() const{
+    return GoLBoundary::Unbounded;
+}
+
+//-------------------------------------------------------------------------------------
+//---------- HashLifeEngine -----------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+HashLifeEngine::HashLifeEngine(int rows, int cols) : LifeEngine(rows, cols), game(), window(nullptr) {
+    window = new bool*[rows];
+    for(int i = 0; i < rows; i++){
+        window[i] = new bool[cols];
+        for(int j = 0; j < cols; j++){
+            window[i][j] = false;
+        }
+    }
+    game.setBoard(rows, cols, window);
+}
+
+HashLifeEngine::~HashLifeEngine(){
+    for(int i = 0; i < rows; i++){
+        delete[](window[i]);
+    }
+    delete[](window);
+}
+
+//---------- UTILITIES ----------
+void HashLifeEngine::reset(int orgRows, int orgCols, char* organism){
+    // Build the window with the organism in it
+    int rowPad = (rows - orgRows) / 2;
+    int colPad = (cols - orgCols) / 2;
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            window[i][j] = false;
+        }
+    }
+    int index = 0;
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            window[rowPad + i][colPad + j] = (bool) organism[index];
+            index++;
+        }
+    }
+    game.setBoard(rows, cols, window);
+}
+
+void HashLifeEngine::setBoard(bool** data){
+    game.setBoard(rows, cols, data);
+}
+
+void HashLifeEngine::getBoardSafe(bool** data){
+    game.getBoardSafe(data);
+}
+
+void HashLifeEngine::advance(long long generations){
+    game.advance((uint64_t) generations);
+}
+
+//---------- ACCESSORS ----------
+long long HashLifeEngine::getPopulation(){
+    return (long long) game.getPopulation();
+}
+
+LifeBackend HashLifeEngine::getBackend() const{
+    return LifeBackend::HashLife;
+}
+
+GoLBoundary HashLifeEngine::getBoundary() const{
+    return GoLBoundary::Unbounded;
+}
+
+//---------- ENGINE SELECTION ----------
+const char* lifeBackendName(LifeBackend backend){
+    switch(backend){
+        case LifeBackend::Dense:
+            return "Dense";
+        case LifeBackend::Packed:
+            return "Packed";
+        case LifeBackend::Sparse:
+            return "Sparse";
+        case LifeBackend::HashLife:
+            return "HashLife";
+    }
+    return "Unknown";
+}
+
+LifeEngine* createLifeEngine(LifeBackend backend, int rows, int cols){
+    switch(backend){
+        case LifeBackend::Dense:
+            return new DenseLifeEngine(rows, cols);
+        case LifeBackend::Packed:
+            return new PackedLifeEngine(rows, cols);
+        case LifeBackend::Sparse:
+            return new SparseLifeEngine(rows, cols);
+        case LifeBackend::HashLife:
+            return new HashLifeEngine(rows, cols);
+    }
+    return nullptr;
+}
+
+LifeBackend selectLifeBackend(int rows, int cols, bool** data, GoLBoundary boundary, long long generations){
+    // Engines that can run the boundary, the first is the default
+    LifeBackend candidates[2];
+    if(boundary == GoLBoundary::Unbounded){
+        candidates[0] = LifeBackend::Sparse;
+        candidates[1] = LifeBackend::HashLife;
+    } else {
+        candidates[0] = LifeBackend::Dense;
+        candidates[1] = LifeBackend::Packed;
+    }
+
+    // Calibrating would take a good part of the run itself
+    int shortRun = LIFE_ENGINE_CALIBRATION_STEPS;
+    int longRun = 4 * LIFE_ENGINE_CALIBRATION_STEPS;
+    if(generations < 4 * (shortRun + longRun)){
+        return candidates[0];
+    }
+
+    // Time a short and a long run on each engine and fit time = a * generations^b, which captures the memoization of HashLife as well as the engines linear in time
+    LifeBackend best = candidates[0];
+    double bestTime = 0.0;
+    for(int c = 0; c < 2; c++){
+        LifeEngine* engine = createLifeEngine(candidates[c], rows, cols);
+        engine->setBoard(data);
+        auto start = chrono::steady_clock::now();
+        engine->advance(shortRun);
+        auto middle = chrono::steady_clock::now();
+        engine->advance(longRun);
+        auto end = chrono::steady_clock::now();
+        delete(engine);
+
+        // Keep the times away from 0 so boards that do nothing still fit
+        double shortTime = max(chrono::duration<double>(middle - start).count(), 1e-9);
+        double longTime = max(chrono::duration<double>(end - middle).count(), 1e-9);
+        double exponent = min(1.0, max(0.0, log(longTime / shortTime) / log((double) longRun / shortRun)));
+        double expectedTime = shortTime * pow((double) generations / shortRun, exponent);
+        if(c == 0 || expectedTime < bestTime){
+            best = candidates[c];
+            bestTime = expectedTime;
+        }
+    }
+    return best;
+}
+
+LifeEngine* selectLifeEngine(int rows, int cols, bool** data, GoLBoundary boundary, long long generations){
+    LifeEngine* engine = createLifeEngine(selectLifeBackend(rows, cols, data, boundary, generations), rows, cols);
+    engine->setBoard(data);
+    return engine;
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_LifeEngine(){
+    // Random board
+    int rows = 96;
+    int cols = 80;
+    bool** start = new bool*[rows];
+    bool** expected = new bool*[rows];
+    bool** result = new bool*[rows];
+    for(int i = 0; i < rows; i++){
+        start[i] = new bool[cols];
+        expected[i] = new bool[cols];
+        result[i] = new bool[cols];
+        for(int j = 0; j < cols; j++){
+            start[i][j] = rng::genRandDouble(0.0, 1.0) < 0.3;
+        }
+    }
+
+    // The engines of each boundary should agree with each other
+    LifeBackend backends[] = {LifeBackend::Dense, LifeBackend::Packed, LifeBackend::Sparse, LifeBackend::HashLife};
+    int generations = 300;
+    long long expectedPopulation = 0;
+    for(int b = 0; b < 4; b++){
+        LifeEngine* engine = createLifeEngine(backends[b], rows, cols);
+        engine->setBoard(start);
+        engine->advance(generations / 3);
+        engine->advance(generations - generations / 3);
+
+        // The first engine of every boundary is the reference
+        bool passed = engine->getBoundary() == (b < 2 ? GoLBoundary::Toroidal : GoLBoundary::Unbounded);
+        bool** board = b % 2 == 0 ? expected : result;
+        engine->getBoardSafe(board);
+        if(b % 2 == 0){
+            expectedPopulation = engine->getPopulation();
+        } else {
+            passed = passed && engine->getPopulation() == expectedPopulation;
+            for(int i = 0; i < rows && passed; i++){
+                for(int j = 0; j < cols && passed; j++){
+                    passed = expected[i][j] == result[i][j];
+                }
+            }
+            cout << lifeBackendName(backends[b]) << " against " << lifeBackendName(backends[b - 1]) << ": " << (passed ? "PASSED" : "FAILED") << "\n";
+        }
+        delete(engine);
+    }
+
+    // A glider in an otherwise empty universe is memoized by HashLife, which should win the long runs
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            start[i][j] = false;
+        }
+    }
+    start[1][2] = true;
+    start[2][3] = true;
+    start[3][1] = true;
+    start[3][2] = true;
+    start[3][3] = true;
+    for(long long run : {10LL, 1000LL, 100000LL}){
+        for(GoLBoundary boundary : {GoLBoundary::Toroidal, GoLBoundary::Unbounded}){
+            auto begin = chrono::steady_clock::now();
+            LifeEngine* engine = selectLifeEngine(rows, cols, start, boundary, run);
+            auto selected = chrono::steady_clock::now();
+            engine->advance(run);
+            auto end = chrono::steady_clock::now();
+            bool passed = engine->getBoundary() == boundary && engine->getPopulation() == 5;
+            cout << "Selected " << lifeBackendName(engine->getBackend()) << " for " << run << (boundary == GoLBoundary::Toroidal ? " toroidal" : " unbounded") << " generations: " << (passed ? "PASSED" : "FAILED");
+            cout << " (selection " << chrono::duration<double>(selected - begin).count() << "s, run " << chrono::duration<double>(end - selected).count() << "s)\n";
+            delete(engine);
+        }
+    }
+
+    // The GA should give the same fitness through every engine of its boundary, and on the torus the same as the plain stepper
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles};
+    for(int b = 0; b < 4; b++){
+        GoLBoundary boundary = b < 2 ? GoLBoundary::Toroidal : GoLBoundary::Unbounded;
+        bool passed = true;
+        for(int f = 0; f < 2 && passed; f++){
+            GameOfLifeGA ga = GameOfLifeGA(20, 64, 2, actions, 1, 0.1, 1, 30, 30, functions[f], 200, 8, 8, boundary);
+            // Small tiles and sparse members that die out early go to sleep on their own, which the plain stepper has to agree with
+            ga.setTileSize(4);
+            sparseMembers(ga, 5, 0.1);
+            GameOfLifeGA engineGA = GameOfLifeGA(ga);
+            engineGA.setLifeEngine(createLifeEngine(backends[b], 30, 30));
+            for(int member = 0; member < 20 && passed; member++){
+                double fitness = engineGA.fitness(member);
+                passed = ga.fitness(member) == fitness;
+                if(boundary == GoLBoundary::Toroidal){
+                    char* organism = ga.getMember(member);
+                    passed = passed && fitness == ga.projectMetrics(referenceMetrics(30, 30, 8, 8, organism, 200), functions[f]);
+                    delete[](organism);
+                }
+            }
+        }
+        cout << "GameOfLifeGA through " << lifeBackendName(backends[b]) << ": " << (passed ? "PASSED" : "FAILED") << "\n";
+    }
+
+    // Cleanup
+    for(int i = 0; i < rows; i++){
+        delete[](start[i]);
+        delete[](expected[i]);
+        delete[](result[i]);
+    }
+    delete[](start);
+    delete[](expected);
+    delete[](result);
+}
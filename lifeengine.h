@@ -0,0 +1,167 @@
+#ifndef LIFE_ENGINE_H
+#define LIFE_ENGINE_H
+
+#include "gameoflife.h"
+#include "bitgameoflife.h"
+#include "sparsegameoflife.h"
+#include "hashlife.h"
+
+using namespace std;
+
+/*
+Life Engine
+
+A common interface over the Game of Life simulations in this project, so code that only needs to load a board, run it forward and read it back can be handed whichever one is fastest for the job. Every engine works on a rows x cols window:
+- Dense - the GameOfLife class, one byte per cell with sleeping tiles, toroidal
+- Packed - the BitGameOfLife class, 64 cells per word, toroidal
+- Sparse - the SparseGameOfLife class, only the occupied 64 x 64 chunks, unbounded
+- HashLife - the HashLife class, memoized quadtree, unbounded
+
+The toroidal engines give identical results to each other, as do the unbounded ones. All of them run Conway's rule.
+
+selectLifeEngine() picks between the engines of a boundary by timing two short runs of the actual board on each and fitting how the time grows with the number of generations, so the choice reflects the size, density and structure of the board as well as the number of generations asked for.
+*/
+
+//---------- CONSTANTS ----------
+// Number of generations of the first calibration run, the second runs 4 times as many
+const int LIFE_ENGINE_CALIBRATION_STEPS = 16;
+
+// Simulations behind the LifeEngine interface
+enum class LifeBackend {
+    Dense,
+    Packed,
+    Sparse,
+    HashLife
+};
+
+class LifeEngine{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        LifeEngine(int rows, int cols);
+        // Engines may hold simulations that can not be copied, use createLifeEngine() with getBackend() instead
+        LifeEngine(const LifeEngine & other) = delete;
+        LifeEngine& operator=(const LifeEngine & other) = delete;
+        virtual ~LifeEngine();
+
+        //---------- UTILITIES ----------
+        // Clears the board and adds the organism in the same place GameOfLife::addOrganism puts it
+        virtual void reset(int orgRows, int orgCols, char* organism) = 0;
+        // Overwrites the rows x cols window with the data, clearing everything else
+        virtual void setBoard(bool** data) = 0;
+        // Creates a copy of the rows x cols window overwriting the data
+        virtual void getBoardSafe(bool** data) = 0;
+        // Advances the board the number of generations
+        virtual void advance(long long generations) = 0;
+
+        //---------- ACCESSORS ----------
+        // Number of cells that are on, including any outside of the window for the unbounded engines
+        virtual long long getPopulation() = 0;
+        virtual LifeBackend getBackend() const = 0;
+        virtual GoLBoundary getBoundary() const = 0;
+        int getRows() const;
+        int getCols() const;
+    protected:
+        // Size of the window
+        int rows;
+        int cols;
+};
+
+class DenseLifeEngine : public LifeEngine {
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        DenseLifeEngine(int rows, int cols);
+
+        //---------- UTILITIES ----------
+        void reset(int orgRows, int orgCols, char* organism);
+        void setBoard(bool** data);
+        void getBoardSafe(bool** data);
+        // Uses the temporally blocked stepMany() once the board is too large for the cache
+        void advance(long long generations);
+
+        //---------- ACCESSORS ----------
+        long long getPopulation();
+        LifeBackend getBackend() const;
+        GoLBoundary getBoundary() const;
+    private:
+        // The simulation
+        GameOfLife game;
+};
+
+class PackedLifeEngine : public LifeEngine {
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        PackedLifeEngine(int rows, int cols);
+
+        //---------- UTILITIES ----------
+        void reset(int orgRows, int orgCols, char* organism);
+        void setBoard(bool** data);
+        void getBoardSafe(bool** data);
+        void advance(long long generations);
+
+        //---------- ACCESSORS ----------
+        long long getPopulation();
+        LifeBackend getBackend() const;
+        GoLBoundary getBoundary() const;
+    private:
+        // The simulation
+        BitGameOfLife game;
+};
+
+class SparseLifeEngine : public LifeEngine {
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        SparseLifeEngine(int rows, int cols);
+
+        //---------- UTILITIES ----------
+        void reset(int orgRows, int orgCols, char* organism);
+        void setBoard(bool** data);
+        void getBoardSafe(bool** data);
+        void advance(long long generations);
+
+        //---------- ACCESSORS ----------
+        long long getPopulation();
+        LifeBackend getBackend() const;
+        GoLBoundary getBoundary() const;
+    private:
+        // The simulation
+        SparseGameOfLife game;
+};
+
+class HashLifeEngine : public LifeEngine {
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        HashLifeEngine(int rows, int cols);
+        ~HashLifeEngine();
+
+        //---------- UTILITIES ----------
+        void reset(int orgRows, int orgCols, char* organism);
+        void setBoard(bool** data);
+        void getBoardSafe(bool** data);
+        void advance(long long generations);
+
+        //---------- ACCESSORS ----------
+        long long getPopulation();
+        LifeBackend getBackend() const;
+        GoLBoundary getBoundary() const;
+    private:
+        // The simulation
+        HashLife game;
+        // Scratch rows x cols window used to load organisms
+        bool** window;
+};
+
+//---------- ENGINE SELECTION ----------
+// Human readable name of the backend
+const char* lifeBackendName(LifeBackend backend);
+// Creates an engine of the backend with a rows x cols window, the caller owns the engine
+LifeEngine* createLifeEngine(LifeBackend backend, int rows, int cols);
+// Times the engines of the boundary on the rows x cols board and returns the one expected to advance it the number of generations the fastest
+// Boards too short lived to be worth calibrating get the default engine of the boundary, Dense or Sparse
+LifeBackend selectLifeBackend(int rows, int cols, bool** data, GoLBoundary boundary, long long generations);
+// Creates the engine picked by selectLifeBackend() loaded with the board, the caller owns the engine
+LifeEngine* selectLifeEngine(int rows, int cols, bool** data, GoLBoundary boundary, long long generations);
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_LifeEngine();
+
+#endif
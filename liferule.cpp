@@ -0,0 +1,232 @@
+#include <cctype>
+#include <iostream>
+#include <mutex>
+
+#include "rng.h"
+#include "kernels.h"
+#include "liferule.h"
+
+//---------- HELPER FUNCTIONS ----------
+// Bit mask of a list of counts
+constexpr uint16_t counts(std::initializer_list<int> list){
+    uint16_t mask = 0;
+    for(int count : list){
+        mask |= 1 << count;
+    }
+    return mask;
+}
+
+// Shorthand for the row kernel of a rule
+#define LIFE_RULE_ENTRY(name, birth, survive) {name, birth, survive, LifeRule<birth, survive>::row}
+
+// The precompiled rules, Conway's Life uses the vectorized kernel
+static const LifeRuleEntry LIFE_RULES[] = {
+    {"Life", counts({3}), counts({2, 3}), kernels::lifeRow},
+    LIFE_RULE_ENTRY("HighLife", counts({3, 6}), counts({2, 3})),
+    LIFE_RULE_ENTRY("Day & Night", counts({3, 6, 7, 8}), counts({3, 4, 6, 7, 8})),
+    LIFE_RULE_ENTRY("Seeds", counts({2}), counts({})),
+    LIFE_RULE_ENTRY("Life without Death", counts({3}), counts({0, 1, 2, 3, 4, 5, 6, 7, 8})),
+    LIFE_RULE_ENTRY("2x2", counts({3, 6}), counts({1, 2, 5})),
+    LIFE_RULE_ENTRY("Maze", counts({3}), counts({1, 2, 3, 4, 5})),
+    LIFE_RULE_ENTRY("Replicator", counts({1, 3, 5, 7}), counts({1, 3, 5, 7})),
+    LIFE_RULE_ENTRY("DryLife", counts({3, 7}), counts({2, 3})),
+    LIFE_RULE_ENTRY("Morley", counts({3, 6, 8}), counts({2, 4, 5})),
+    LIFE_RULE_ENTRY("34 Life", counts({3, 4}), counts({3, 4})),
+    LIFE_RULE_ENTRY("Diamoeba", counts({3, 5, 6, 7, 8}), counts({5, 6, 7, 8}))
+};
+
+#undef LIFE_RULE_ENTRY
+
+// Reads a list of neighbor counts into the mask, returns false on anything but digits 0 - 8
+static bool parseCounts(const string& digits, uint16_t& mask){
+    mask = 0;
+    for(char digit : digits){
+        if(digit < '0' || digit > '8'){
+            return false;
+        }
+        mask |= 1 << (digit - '0');
+    }
+    return true;
+}
+
+//---------- FUNCTIONS ----------
+bool parseLifeRule(const string& rule, uint16_t& birth, uint16_t& survive){
+    size_t slash = rule.find('/');
+    if(slash == string::npos){
+        return false;
+    }
+    string first = rule.substr(0, slash);
+    string second = rule.substr(slash + 1);
+
+    // S/B notation has no letters and gives the survival counts first
+    if(first.empty() || isdigit(first[0])){
+        return (second.empty() || isdigit(second[0])) && parseCounts(first, survive) && parseCounts(second, birth);
+    }
+
+    // B/S notation in either order
+    char firstLetter = toupper(first[0]);
+    char secondLetter = second.empty() ? '\0' : toupper(second[0]);
+    if(firstLetter == 'S' && secondLetter == 'B'){
+        swap(first, second);
+    } else if(firstLetter != 'B' || secondLetter != 'S'){
+        return false;
+    }
+    return parseCounts(first.substr(1), birth) && parseCounts(second.substr(1), survive);
+}
+
+string lifeRuleString(uint16_t birth, uint16_t survive){
+    string rule = "B";
+    for(int count = 0; count < LIFE_RULE_COUNTS; count++){
+        if((birth >> count) & 1){
+            rule += (char) ('0' + count);
+        }
+    }
+    rule += "/S";
+    for(int count = 0; count < LIFE_RULE_COUNTS; count++){
+        if((survive >> count) & 1){
+            rule += (char) ('0' + count);
+        }
+    }
+    return rule;
+}
+
+const LifeRuleEntry* findLifeRule(const string& rule){
+    uint16_t birth;
+    uint16_t survive;
+    if(!parseLifeRule(rule, birth, survive)){
+        return nullptr;
+    }
+    return findLifeRule(birth, survive);
+}
+
+const LifeRuleEntry* findLifeRule(uint16_t birth, uint16_t survive){
+    for(const LifeRuleEntry& entry : LIFE_RULES){
+        if(entry.birth == birth && entry.survive == survive){
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const LifeRuleEntry* getLifeRules(int& numRules){
+    numRules = sizeof(LIFE_RULES) / sizeof(LIFE_RULES[0]);
+    return LIFE_RULES;
+}
+
+const uint8_t* getLifeBlockTable(const LifeRuleEntry* rule){
+    // One table per precompiled rule, built on demand
+    static uint8_t* tables[sizeof(LIFE_RULES) / sizeof(LIFE_RULES[0])] = {};
+    static mutex tablesLock;
+    int index = rule - LIFE_RULES;
+
+    lock_guard<mutex> guard(tablesLock);
+    if(!tables[index]){
+        uint8_t* table = new uint8_t[1 << 16];
+        for(int block = 0; block < (1 << 16); block++){
+            uint8_t next = 0;
+            uint8_t changed = 0;
+            for(int k = 0; k < 4; k++){
+                // Center cell (1 + k / 2, 1 + k % 2) of the block
+                int row = 1 + k / 2;
+                int col = 1 + k % 2;
+                int neighbors = 0;
+                for(int dr = -1; dr <= 1; dr++){
+                    for(int dc = -1; dc <= 1; dc++){
+                        if(dr != 0 || dc != 0){
+                            neighbors += (block >> (4 * (col + dc) + row + dr)) & 1;
+                        }
+                    }
+                }
+                bool alive = (block >> (4 * col + row)) & 1;
+                bool result = ((alive ? rule->survive : rule->birth) >> neighbors) & 1;
+                next |= result << k;
+                changed |= (result != alive) << k;
+            }
+            table[block] = next | (changed << 4);
+        }
+        tables[index] = table;
+    }
+    return tables[index];
+}
+
+int lifeBlockRows(const bool* up, const bool* top, const bool* bottom, const bool* down, bool* nextTop, bool* nextBottom, int n, const uint8_t* table){
+    // Count of the changed tiles
+    int count = 0;
+
+    // The 4 cells of a column packed into a nibble
+    auto column = [&](int j){
+        return up[j] | (top[j] << 1) | (bottom[j] << 2) | (down[j] << 3);
+    };
+
+    // Slide the 4x4 window two columns at a time, only the two new columns are read each time
+    int block = column(-1) | (column(0) << 4);
+    int j = 0;
+    for(; j + 1 < n; j += 2){
+        block = (block & 0xFF) | (column(j + 1) << 8) | (column(j + 2) << 12);
+        uint8_t result = table[block];
+        nextTop[j] = result & 1;
+        nextTop[j + 1] = (result >> 1) & 1;
+        nextBottom[j] = (result >> 2) & 1;
+        nextBottom[j + 1] = (result >> 3) & 1;
+        count += __builtin_popcount(result >> 4);
+        block >>= 8;
+    }
+
+    // An odd last column uses the left half of a block that ends one past the range
+    if(j < n){
+        block = (block & 0xFF) | (column(j + 1) << 8);
+        uint8_t result = table[block];
+        nextTop[j] = result & 1;
+        nextBottom[j] = (result >> 2) & 1;
+        count += __builtin_popcount((result >> 4) & 0x5);
+    }
+    return count;
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_LifeRule(){
+    // Parsing in every notation
+    uint16_t birth;
+    uint16_t survive;
+    bool passed = parseLifeRule("B3/S23", birth, survive) && birth == counts({3}) && survive == counts({2, 3});
+    passed = passed && parseLifeRule("s23/b36", birth, survive) && birth == counts({3, 6}) && survive == counts({2, 3});
+    passed = passed && parseLifeRule("23/3", birth, survive) && birth == counts({3}) && survive == counts({2, 3});
+    passed = passed && parseLifeRule("B2/S", birth, survive) && birth == counts({2}) && survive == 0;
+    passed = passed && !parseLifeRule("B9/S23", birth, survive) && !parseLifeRule("B3S23", birth, survive) && !parseLifeRule("X3/S23", birth, survive);
+    passed = passed && lifeRuleString(counts({3, 6}), counts({2, 3})) == "B36/S23";
+    passed = passed && findLifeRule("B36/S23") && string(findLifeRule("B36/S23")->name) == "HighLife" && !findLifeRule("B1/S1");
+    cout << "LifeRule parsing: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Every precompiled kernel against a brute force count of the neighbors
+    int size = 300;
+    bool* rows[3];
+    for(int k = 0; k < 3; k++){
+        rows[k] = new bool[size + 2];
+        for(int j = 0; j < size + 2; j++){
+            rows[k][j] = rng::genRandDouble(0.0, 1.0) < 0.4;
+        }
+    }
+    bool* next = new bool[size];
+    int numRules;
+    const LifeRuleEntry* rules = getLifeRules(numRules);
+    for(int r = 0; r < numRules; r++){
+        int changes = rules[r].row(rows[0] + 1, rows[1] + 1, rows[2] + 1, next, size);
+        int expectedChanges = 0;
+        passed = true;
+        for(int j = 1; j <= size && passed; j++){
+            int neighbors = -rows[1][j];
+            for(int k = 0; k < 3; k++){
+                neighbors += rows[k][j - 1] + rows[k][j] + rows[k][j + 1];
+            }
+            bool expected = ((rows[1][j] ? rules[r].survive : rules[r].birth) >> neighbors) & 1;
+            expectedChanges += expected != rows[1][j];
+            passed = next[j - 1] == expected;
+        }
+        passed = passed && changes == expectedChanges;
+        cout << "LifeRule " << rules[r].name << " " << lifeRuleString(rules[r].birth, rules[r].survive) << ": " << (passed ? "PASSED" : "FAILED") << "\n";
+    }
+    for(int k = 0; k < 3; k++){
+        delete[](rows[k]);
+    }
+    delete[](next);
+}
@@ -0,0 +1,100 @@
+#ifndef LIFE_RULE_H
+#define LIFE_RULE_H
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+/*
+Life-like Rules
+
+Outer totalistic rules in B/S notation, e.g. Conway's Game of Life is B3/S23 - a dead cell with 3 neighbors is born and a live cell with 2 or 3 neighbors survives. The birth and survival counts are stored as bit masks where bit k means k neighbors.
+
+LifeRule<Birth, Survive> bakes a rule into the type so its transition table is built at compile time and its row kernel has the rule folded in as constants. Only a fixed set of rules is instantiated, findLifeRule() turns a rule string into the kernel of one of them at runtime, so picking a rule costs one lookup when it is set and nothing while stepping.
+*/
+
+//---------- CONSTANTS ----------
+// Number of possible neighbor counts, 0 through 8
+const int LIFE_RULE_COUNTS = 9;
+
+// Row kernel shared by every rule, see kernels::lifeRow for the arguments
+typedef int (*LifeRowKernel)(const bool* up, const bool* mid, const bool* down, bool* next, int n);
+
+// Transition table indexed by alive * 9 + count
+struct LifeTable {
+    bool next[2 * LIFE_RULE_COUNTS];
+};
+
+// Builds the transition table of the rule
+constexpr LifeTable makeLifeTable(uint16_t birth, uint16_t survive){
+    LifeTable table = {};
+    for(int count = 0; count < LIFE_RULE_COUNTS; count++){
+        table.next[count] = (birth >> count) & 1;
+        table.next[LIFE_RULE_COUNTS + count] = (survive >> count) & 1;
+    }
+    return table;
+}
+
+template<uint16_t Birth, uint16_t Survive>
+struct LifeRule {
+    // Counts that give birth and counts that survive as bit masks
+    static constexpr uint16_t birth = Birth;
+    static constexpr uint16_t survive = Survive;
+    // Transition table of the rule
+    static constexpr LifeTable table = makeLifeTable(Birth, Survive);
+
+    // Applies the rule to the cells [0, n) of a row, reading the cells [-1, n] of the rows above, at and below it
+    // Returns the number of cells that changed
+    static int row(const bool* up, const bool* mid, const bool* down, bool* next, int n){
+        int count = 0;
+        for(int j = 0; j < n; j++){
+            int neighbors = up[j - 1] + up[j] + up[j + 1] + mid[j - 1] + mid[j + 1] + down[j - 1] + down[j] + down[j + 1];
+            next[j] = table.next[mid[j] * LIFE_RULE_COUNTS + neighbors];
+            count += next[j] != mid[j];
+        }
+        return count;
+    }
+};
+
+// Conway's Game of Life
+typedef LifeRule<1 << 3, (1 << 2) | (1 << 3)> ConwayRule;
+
+// A precompiled rule
+struct LifeRuleEntry {
+    // Common name of the rule
+    const char* name;
+    uint16_t birth;
+    uint16_t survive;
+    // Row kernel of the rule
+    LifeRowKernel row;
+};
+
+//---------- FUNCTIONS ----------
+// Parses a rule string in B/S notation (e.g. "B36/S23", either order, any case) or the older S/B notation (e.g. "23/36") into the masks
+// Returns false if the string is not a rule
+bool parseLifeRule(const string& rule, uint16_t& birth, uint16_t& survive);
+
+// Formats the masks as a B/S rule string
+string lifeRuleString(uint16_t birth, uint16_t survive);
+
+// Returns the precompiled rule matching the string or the masks, nullptr if the rule is not one of them
+const LifeRuleEntry* findLifeRule(const string& rule);
+const LifeRuleEntry* findLifeRule(uint16_t birth, uint16_t survive);
+
+// Every precompiled rule
+const LifeRuleEntry* getLifeRules(int& numRules);
+
+// Returns the 4x4 block table of the rule, built the first time it is asked for and shared afterwards
+// The table is indexed by the 16 cells of a 4x4 block, column by column with bit 4 * col + row, the low 4 bits of an entry hold the next state of the center 2x2 cells
+// (bit 0 top left, bit 1 top right, bit 2 bottom left, bit 3 bottom right) and the high 4 bits hold which of them changed
+const uint8_t* getLifeBlockTable(const LifeRuleEntry* rule);
+
+// Applies the rule to the cells [0, n) of two rows with a single table lookup per 2x2 block, reading the cells [-1, n] of the rows above, at and below them
+// Returns the number of cells that changed
+int lifeBlockRows(const bool* up, const bool* top, const bool* bottom, const bool* down, bool* nextTop, bool* nextBottom, int n, const uint8_t* table);
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_LifeRule();
+
+#endif
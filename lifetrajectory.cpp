@@ -0,0 +1,346 @@
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "rng.h"
+#include "lifetrajectory.h"
+#include "bitutils.h"
+#include "bitgameoflife.h"
+#include "gameoflife.h"
+
+//-------------------------------------------------------------------------------------
+//---------- LifeTrajectory -----------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+LifeTrajectory::LifeTrajectory() : LifeTrajectory(0, 1) {}
+
+LifeTrajectory::LifeTrajectory(int rows, int cols) : rows(rows), cols(cols), rowsStepped(0) {
+    rowMask = cols >= BIT_GAME_OF_LIFE_WORD_BITS ? ~((uint64_t) 0) : (((uint64_t) 1) << cols) - 1;
+}
+
+LifeTrajectory::~LifeTrajectory(){}
+
+//---------- UTILITIES ----------
+void LifeTrajectory::placeOrganism(int orgRows, int orgCols, char* organism, vector<uint64_t>& start) const{
+    start.assign(rows, 0);
+
+    // Copy the organism into roughly the center of the board
+    int rowPad = (rows - orgRows) / 2;
+    int colPad = (cols - orgCols) / 2;
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            start[rowPad + i] |= (uint64_t) (organism[i * orgCols + j] != 0) << (colPad + j);
+        }
+    }
+}
+
+int LifeTrajectory::startDistance(const vector<uint64_t>& start) const{
+    if(boards.empty()){
+        return INT_MAX;
+    }
+    int distance = 0;
+    for(int i = 0; i < rows; i++){
+        distance += __builtin_popcountll(start[i] ^ boards[i]);
+    }
+    return distance;
+}
+
+void LifeTrajectory::simulate(const vector<uint64_t>& start, int maxSteps, bool stopAtCycle){
+    boards.clear();
+    boards.reserve((size_t) (maxSteps + 1) * rows);
+    boards.insert(boards.end(), start.begin(), start.begin() + rows);
+    stats.clear();
+    detector.reset();
+    rowsStepped = 0;
+
+    // The starting board
+    LifeStepStatistics stepStats;
+    for(int i = 0; i < rows; i++){
+        addRow(stepStats, start[i], i, 1);
+    }
+    if(record(stepStats, stopAtCycle)){
+        return;
+    }
+
+    for(int k = 1; k <= maxSteps; k++){
+        boards.resize(boards.size() + rows);
+        uint64_t* next = boards.data() + (size_t) k * rows;
+        const uint64_t* prev = next - rows;
+        stepStats = LifeStepStatistics();
+        for(int i = 0; i < rows; i++){
+            next[i] = stepRow(prev, i);
+            addRow(stepStats, next[i], i, 1);
+            stepStats.changes += __builtin_popcountll(next[i] ^ prev[i]);
+        }
+        rowsStepped += rows;
+        if(record(stepStats, stopAtCycle)){
+            return;
+        }
+    }
+}
+
+void LifeTrajectory::simulateFrom(const LifeTrajectory& parent, const vector<uint64_t>& start, int maxSteps, bool stopAtCycle){
+    // The parent has to cover every generation
+    bool covered = (int) parent.stats.size() > maxSteps || parent.detector.foundCycle();
+    if(parent.rows != rows || parent.cols != cols || parent.stats.empty() || !covered){
+        simulate(start, maxSteps, stopAtCycle);
+        return;
+    }
+
+    boards.clear();
+    boards.reserve((size_t) (maxSteps + 1) * rows);
+    boards.insert(boards.end(), start.begin(), start.begin() + rows);
+    stats.clear();
+    detector.reset();
+    rowsStepped = 0;
+
+    // Patch the statistics of the parent with the rows that differ
+    vector<char> differs(rows, 0);
+    vector<char> nextDiffers(rows, 0);
+    const uint64_t* parentBoard = parent.getBoard(0);
+    LifeStepStatistics stepStats = parent.stats[0];
+    for(int i = 0; i < rows; i++){
+        if(start[i] != parentBoard[i]){
+            differs[i] = 1;
+            addRow(stepStats, parentBoard[i], i, -1);
+            addRow(stepStats, start[i], i, 1);
+        }
+    }
+    if(record(stepStats, stopAtCycle)){
+        return;
+    }
+
+    bool full = false;
+    for(int k = 1; k <= maxSteps; k++){
+        boards.resize(boards.size() + rows);
+        uint64_t* next = boards.data() + (size_t) k * rows;
+        const uint64_t* prev = next - rows;
+
+        // A row can only differ after the step if it or a row next to it differed before
+        // Patching a row costs about twice as much as stepping it, so past half of the rows the parent is no help anymore
+        if(!full){
+            int candidates = 0;
+            for(int i = 0; i < rows; i++){
+                candidates += differs[i] || differs[i == 0 ? rows - 1 : i - 1] || differs[i == rows - 1 ? 0 : i + 1];
+            }
+            full = 2 * candidates > rows;
+        }
+
+        if(full){
+            // The rest is simulated in full
+            stepStats = LifeStepStatistics();
+            for(int i = 0; i < rows; i++){
+                next[i] = stepRow(prev, i);
+                addRow(stepStats, next[i], i, 1);
+                stepStats.changes += __builtin_popcountll(next[i] ^ prev[i]);
+            }
+            rowsStepped += rows;
+        } else {
+            // Start from the parent and redo the rows that can differ
+            const uint64_t* parentPrev = parent.getBoard(k - 1);
+            const uint64_t* parentNext = parent.getBoard(k);
+            memcpy(next, parentNext, rows * sizeof(uint64_t));
+            stepStats = parent.getStatistics(k);
+            for(int i = 0; i < rows; i++){
+                nextDiffers[i] = 0;
+                if(!differs[i] && !differs[i == 0 ? rows - 1 : i - 1] && !differs[i == rows - 1 ? 0 : i + 1]){
+                    continue;
+                }
+                uint64_t word = stepRow(prev, i);
+                addRow(stepStats, parentNext[i], i, -1);
+                stepStats.changes -= __builtin_popcountll(parentNext[i] ^ parentPrev[i]);
+                addRow(stepStats, word, i, 1);
+                stepStats.changes += __builtin_popcountll(word ^ prev[i]);
+                next[i] = word;
+                nextDiffers[i] = word != parentNext[i];
+                rowsStepped++;
+            }
+            differs.swap(nextDiffers);
+        }
+
+        if(record(stepStats, stopAtCycle)){
+            return;
+        }
+    }
+}
+
+//---------- ACCESSORS ----------
+int LifeTrajectory::getRows() const{
+    return rows;
+}
+
+int LifeTrajectory::getCols() const{
+    return cols;
+}
+
+int LifeTrajectory::getGenerations() const{
+    return (int) stats.size();
+}
+
+const LifeStepStatistics& LifeTrajectory::getStatistics(int generation) const{
+    int last = (int) stats.size() - 1;
+    if(generation <= last || !detector.foundCycle()){
+        return stats[min(generation, last)];
+    }
+
+    // The generations after the cycle start are counted from the one after it, so the changes are those of a step within the cycle
+    int cycleStart = detector.getCycleStart();
+    return stats[cycleStart + 1 + (generation - cycleStart - 1) % detector.getPeriod()];
+}
+
+const CycleDetector& LifeTrajectory::getDetector() const{
+    return detector;
+}
+
+long long LifeTrajectory::getRowsStepped() const{
+    return rowsStepped;
+}
+
+//---------- PRIVATE UTILITIES ----------
+const uint64_t* LifeTrajectory::getBoard(int generation) const{
+    int last = (int) stats.size() - 1;
+    if(generation > last && detector.foundCycle()){
+        int cycleStart = detector.getCycleStart();
+        generation = cycleStart + 1 + (generation - cycleStart - 1) % detector.getPeriod();
+    }
+    return boards.data() + (size_t) min(generation, last) * rows;
+}
+
+uint64_t LifeTrajectory::stepRow(const uint64_t* board, int row) const{
+    uint64_t up = board[row == 0 ? rows - 1 : row - 1];
+    uint64_t mid = board[row];
+    uint64_t down = board[row == rows - 1 ? 0 : row + 1];
+
+    // Neighbors to the west and east of every cell, wrapping around the row
+    uint64_t upWest = ((up << 1) | (up >> (cols - 1))) & rowMask;
+    uint64_t upEast = (up >> 1) | ((up & 1) << (cols - 1));
+    uint64_t midWest = ((mid << 1) | (mid >> (cols - 1))) & rowMask;
+    uint64_t midEast = (mid >> 1) | ((mid & 1) << (cols - 1));
+    uint64_t downWest = ((down << 1) | (down >> (cols - 1))) & rowMask;
+    uint64_t downEast = (down >> 1) | ((down & 1) << (cols - 1));
+    return lifeWord(upWest, up, upEast, midWest, mid, midEast, downWest, down, downEast);
+}
+
+void LifeTrajectory::addRow(LifeStepStatistics& stats, uint64_t word, int row, int sign){
+    if(word == 0){
+        return;
+    }
+    long long count = __builtin_popcountll(word);
+    long long colSum = 0;
+    for(int b = 0; b < 6; b++){
+        colSum += (long long) __builtin_popcountll(word & POSITION_BITS[b]) << b;
+    }
+    stats.population += sign * count;
+    stats.rowSum += sign * count * row;
+    stats.colSum += sign * colSum;
+
+    // XOR of the hashes of the rows, so a row can be taken back out
+    stats.hash ^= mixHash(word ^ mixHash((uint64_t) row + 1));
+}
+
+bool LifeTrajectory::record(const LifeStepStatistics& stepStats, bool stopAtCycle){
+    int generation = (int) stats.size();
+    stats.push_back(stepStats);
+    return stopAtCycle && detector.record(stepStats.hash, generation);
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_LifeTrajectory(){
+    // Children one to a few cells away from a random parent should get the same trajectory from the parent as from scratch
+    int rows = 27;
+    int cols = 27;
+    int maxSteps = 300;
+    LifeTrajectory parent = LifeTrajectory(rows, cols);
+    LifeTrajectory child = LifeTrajectory(rows, cols);
+    LifeTrajectory scratch = LifeTrajectory(rows, cols);
+    vector<uint64_t> parentStart;
+    vector<uint64_t> childStart;
+    char organism[13 * 13];
+    bool passed = true;
+    long long rowsStepped = 0;
+    long long rowsFull = 0;
+    double childTime = 0.0;
+    double scratchTime = 0.0;
+    for(int trial = 0; trial < 200 && passed; trial++){
+        bool stopAtCycle = trial % 4 != 3;
+        for(int i = 0; i < 13 * 13; i++){
+            organism[i] = rng::genRandDouble(0.0, 1.0) < 0.3;
+        }
+        parent.placeOrganism(13, 13, organism, parentStart);
+        parent.simulate(parentStart, maxSteps, stopAtCycle);
+
+        // Flip a few cells
+        int flips = 1 + trial % 3;
+        for(int f = 0; f < flips; f++){
+            int cell = rng::genRandInt(0, 13 * 13 - 1);
+            organism[cell] = !organism[cell];
+        }
+        child.placeOrganism(13, 13, organism, childStart);
+        passed = parent.startDistance(childStart) <= flips;
+
+        auto start = chrono::steady_clock::now();
+        child.simulateFrom(parent, childStart, maxSteps, stopAtCycle);
+        auto middle = chrono::steady_clock::now();
+        scratch.simulate(childStart, maxSteps, stopAtCycle);
+        auto end = chrono::steady_clock::now();
+        childTime += chrono::duration<double>(middle - start).count();
+        scratchTime += chrono::duration<double>(end - middle).count();
+        rowsStepped += child.getRowsStepped();
+        rowsFull += scratch.getRowsStepped();
+
+        passed = passed && child.getGenerations() == scratch.getGenerations() && child.getDetector().getCycleStart() == scratch.getDetector().getCycleStart();
+        for(int k = 0; k <= maxSteps && passed; k++){
+            const LifeStepStatistics& a = child.getStatistics(k);
+            const LifeStepStatistics& b = scratch.getStatistics(k);
+            passed = a.population == b.population && a.rowSum == b.rowSum && a.colSum == b.colSum && a.changes == b.changes && a.hash == b.hash;
+        }
+    }
+    cout << "Differential trajectory: " << (passed ? "PASSED" : "FAILED") << ", " << rowsStepped << " of " << rowsFull << " rows stepped, " << childTime << "s from the parent, " << scratchTime << "s from scratch\n";
+
+    // The statistics should match the GameOfLife class, stepping past the end of a cycle included
+    GameOfLife game = GameOfLife(rows, cols);
+    game.setStatistics(true);
+    game.addOrganism(13, 13, organism);
+    scratch.placeOrganism(13, 13, organism, childStart);
+    scratch.simulate(childStart, maxSteps, true);
+    passed = true;
+    for(int k = 0; k <= maxSteps && passed; k++){
+        long long changes = k > 0 ? game.step() : 0;
+        GoLStatistics stats = game.getStatistics();
+        const LifeStepStatistics& stepStats = scratch.getStatistics(k);
+        passed = stepStats.population == stats.population && stepStats.rowSum == stats.rowSum && stepStats.colSum == stats.colSum && stepStats.changes == changes;
+    }
+    cout << "Trajectory statistics: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // A GameOfLifeGA population a few mutations away from the last one should get the same fitness re-simulated from the last trajectories
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::CenterOfMassMotion, GoLFitnessFunction::Lifespan};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "CenterOfMassMotion", "Lifespan"};
+    for(int f = 0; f < 4; f++){
+        GameOfLifeGA differential = GameOfLifeGA(100, 13 * 13, 2, actions, 1, 0.005, 1, rows, cols, functions[f], maxSteps, 13, 13);
+        differential.setDifferential(true);
+        differential.evalFitness();
+        differential.mutate();
+
+        // The copies start without trajectories
+        GameOfLifeGA fresh = GameOfLifeGA(differential);
+        GameOfLifeGA plain = GameOfLifeGA(differential);
+        plain.setDifferential(false);
+
+        auto start = chrono::steady_clock::now();
+        differential.evalFitness();
+        auto middle = chrono::steady_clock::now();
+        fresh.evalFitness();
+        auto end = chrono::steady_clock::now();
+        plain.evalFitness();
+
+        passed = true;
+        for(int member = 0; member < 100 && passed; member++){
+            double expected = plain.getFitness(member);
+            passed = fabs(differential.getFitness(member) - expected) <= 1e-9 * max(1.0, fabs(expected)) && fresh.getFitness(member) == differential.getFitness(member);
+        }
+        cout << "Differential " << names[f] << ": " << (passed ? "PASSED" : "FAILED") << ", " << chrono::duration<double>(middle - start).count() << "s from the last population, " << chrono::duration<double>(end - middle).count() << "s from scratch\n";
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef LIFE_TRAJECTORY_H
+#define LIFE_TRAJECTORY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "cycledetector.h"
+
+using namespace std;
+
+/*
+Life Trajectory
+
+Every board a toroidal Game of Life passes through from a starting board, one word per row, along with the population, index sums, changes and hash of each generation. Boards can be at most 64 columns wide and only Conway's rule is run.
+
+A trajectory can be simulated from scratch or from a parent trajectory whose starting board differs in a few cells, which is what a single mutation of a genetic algorithm member gives. The child can only differ from the parent in the rows next to the rows it differed in the generation before, so only those rows are stepped and the statistics of the parent are patched with the difference. The rows that differ grow by one on each side per generation at most and often die back out, at which point the child follows the parent at the cost of a copy. Once the difference spreads over more than half of the rows patching costs more than stepping, so the rest is simulated in full.
+*/
+
+// What is on in one generation of a trajectory
+struct LifeStepStatistics {
+    // Number of cells that are on
+    long long population = 0;
+    // Sums of the row and column indices of the cells that are on
+    long long rowSum = 0;
+    long long colSum = 0;
+    // Number of cells that changed in the step into the generation, 0 for the first one
+    long long changes = 0;
+    // Hash of the board, boards hash the same exactly when they are the same (barring collisions)
+    uint64_t hash = 0;
+};
+
+class LifeTrajectory{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        LifeTrajectory();
+        LifeTrajectory(int rows, int cols);
+        ~LifeTrajectory();
+
+        //---------- UTILITIES ----------
+        // Writes the starting board of the organism, placed where GameOfLife::addOrganism puts it, one word per row
+        void placeOrganism(int orgRows, int orgCols, char* organism, vector<uint64_t>& start) const;
+        // Number of cells that differ between the starting board and the first board of the trajectory, INT_MAX if nothing was simulated yet
+        int startDistance(const vector<uint64_t>& start) const;
+        // Simulates maxSteps generations from the starting board, stopping at the first repeated board if stopAtCycle
+        void simulate(const vector<uint64_t>& start, int maxSteps, bool stopAtCycle);
+        // Gives the same trajectory as simulate(), stepping only the rows that can differ from the parent
+        // The parent must have the same size and have been simulated with the same maxSteps and stopAtCycle
+        void simulateFrom(const LifeTrajectory& parent, const vector<uint64_t>& start, int maxSteps, bool stopAtCycle);
+
+        //---------- ACCESSORS ----------
+        int getRows() const;
+        int getCols() const;
+        // Number of generations recorded, including the starting board
+        int getGenerations() const;
+        // Statistics of any generation up to maxSteps, going around the cycle past the recorded generations
+        const LifeStepStatistics& getStatistics(int generation) const;
+        // Cycle found while simulating, if any
+        const CycleDetector& getDetector() const;
+        // Number of rows stepped to make the trajectory, rows * maxSteps for a full simulation without a cycle
+        long long getRowsStepped() const;
+    private:
+        // Size of the board
+        int rows;
+        int cols;
+        // Mask of the columns of a row
+        uint64_t rowMask;
+        // Every recorded board, rows words each
+        vector<uint64_t> boards;
+        // Statistics of every recorded board
+        vector<LifeStepStatistics> stats;
+        // Watches the hashes for a repeated board
+        CycleDetector detector;
+        // Rows stepped to make the trajectory
+        long long rowsStepped;
+
+        //---------- PRIVATE UTILITIES ----------
+        // The board of the generation, going around the cycle past the recorded generations
+        const uint64_t* getBoard(int generation) const;
+        // Next state of the row of the board
+        uint64_t stepRow(const uint64_t* board, int row) const;
+        // Adds the cells of the row to the statistics, or takes them away if sign is -1
+        static void addRow(LifeStepStatistics& stats, uint64_t word, int row, int sign);
+        // Records the statistics of the newest board, returns true if the trajectory should stop
+        bool record(const LifeStepStatistics& stepStats, bool stopAtCycle);
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_LifeTrajectory();
+
+#endif
@@ -13,6 +13,21 @@
 #include "geneticsolver.h"
 #include "cellularautomata.h"
 #include "gameoflife.h"
+#include "bitgameoflife.h"
+#include "batchgameoflife.h"
+#include "fixedgameoflife.h"
+#include "kernels.h"
+#include "hashlife.h"
+#include "threadpool.h"
+#include "sparsegameoflife.h"
+#include "liferule.h"
+#include "lifeengine.h"
+#include "autotune.h"
+#include "cycledetector.h"
+#include "lifetrajectory.h"
+#include "transpositiontable.h"
+#include "fitnesscache.h"
+#include "islandmodel.h"
 #include "rng.h"
 
 //---------- TESTING FUNCTION CONSTANTS ----------
@@ -694,10 +709,38 @@ void printHelpMenu(){
     cerr << "\t\t9 - test the generalized cellular automaton code.\n";
     cerr << "\t\t10 - test the WrapInt Class.\n";
     cerr << "\t\t11 - test the majority function in the basic cellular automaton.\n";
+    cerr << "\t\t12 - test the bit packed BitGameOfLife class against the GameOfLife class.\n";
+    cerr << "\t\t13 - test the vectorized kernels against the scalar kernels.\n";
+    cerr << "\t\t14 - test the HashLife class against the GameOfLife class.\n";
+    cerr << "\t\t15 - test the active tile tracking of the GameOfLife class.\n";
+    cerr << "\t\t16 - test the ThreadPool class.\n";
+    cerr << "\t\t17 - test the multithreaded step of the GameOfLife class against the serial step.\n";
+    cerr << "\t\t18 - test the temporally blocked stepMany of the GameOfLife class against repeated steps.\n";
+    cerr << "\t\t19 - test the unbounded SparseGameOfLife class against the GameOfLife class.\n";
+    cerr << "\t\t20 - test the Life-like rule parsing and kernels.\n";
+    cerr << "\t\t21 - test and time the lookup table kernel of the GameOfLife class against the row kernels.\n";
+    cerr << "\t\t22 - test the CycleDetector class.\n";
+    cerr << "\t\t23 - test the rolling board hash and time the early exit of the GameOfLifeGA fitness functions.\n";
+    cerr << "\t\t24 - test the statistics gathered by the GameOfLife step and time the center of mass fitness with them.\n";
+    cerr << "\t\t25 - test the BatchGameOfLife class and time the batched fitness evaluation of the GameOfLifeGA class.\n";
+    cerr << "\t\t26 - test the LifeEngine backends against each other and time the engine selection.\n";
+    cerr << "\t\t27 - test the autotuner and the tuning file.\n";
+    cerr << "\t\t28 - test and time the light cone of the GameOfLife class and the auto crop of the GameOfLifeGA class.\n";
+    cerr << "\t\t29 - test and time packing the unbounded GameOfLifeGA population onto one plane.\n";
+    cerr << "\t\t30 - test the FixedGameOfLife class and time it in the GameOfLifeGA class.\n";
+    cerr << "\t\t31 - test the LifeTrajectory class and time the differential fitness evaluation of the GameOfLifeGA class.\n";
+    cerr << "\t\t32 - test the TranspositionTable class and time it in the GameOfLifeGA class.\n";
+    cerr << "\t\t33 - test and time evaluating the GameOfLifeGA population on several threads.\n";
+    cerr << "\t\t34 - test the FitnessCache class and time it in the GameOfLifeGA class.\n";
+    cerr << "\t\t35 - test the single pass metrics of the GameOfLifeGA class against the fitness functions and time them.\n";
+    cerr << "\t\t36 - test the IslandModel class and time it on one and several threads.\n";
+    cerr << "\t\t37 - test the steady state training of the GeneticAlgorithm class and time it against generations.\n";
     // Run code
     cerr << "\t-r # - experiment mode with options:\n";
     cerr << "\t\t0 - trains cellular automata to solve the majority problem.\n";
     cerr << "\t\t1 - trains organisms using one of the various fitness functions.\n";
+    // Autotuning
+    cerr << "\t-T - times the GameOfLife settings on this machine and saves the fastest to " << GAME_OF_LIFE_TUNING_FILE << ", which is loaded at startup\n";
 }
 
 // Processes the testing
@@ -739,6 +782,84 @@ void testOptions(int testFlag){
         case 11:
             test_majority(); // PASSED
             break;
+        case 12:
+            test_BitGameOfLife();
+            break;
+        case 13:
+            test_kernels();
+            break;
+        case 14:
+            test_HashLife();
+            break;
+        case 15:
+            test_activeTiles();
+            break;
+        case 16:
+            test_ThreadPool();
+            break;
+        case 17:
+            test_parallelStep();
+            break;
+        case 18:
+            test_stepMany();
+            break;
+        case 19:
+            test_SparseGameOfLife();
+            break;
+        case 20:
+            test_LifeRule();
+            break;
+        case 21:
+            test_lookupTable();
+            break;
+        case 22:
+            test_CycleDetector();
+            break;
+        case 23:
+            test_earlyExit();
+            break;
+        case 24:
+            test_statistics();
+            break;
+        case 25:
+            test_BatchGameOfLife();
+            break;
+        case 26:
+            test_LifeEngine();
+            break;
+        case 27:
+            test_autotune();
+            break;
+        case 28:
+            test_lightCone();
+            break;
+        case 29:
+            test_packing();
+            break;
+        case 30:
+            test_FixedGameOfLife();
+            break;
+        case 31:
+            test_LifeTrajectory();
+            break;
+        case 32:
+            test_TranspositionTable();
+            break;
+        case 33:
+            test_parallelFitness();
+            break;
+        case 34:
+            test_FitnessCache();
+            break;
+        case 35:
+            test_metrics();
+            break;
+        case 36:
+            test_IslandModel();
+            break;
+        case 37:
+            test_steadyState();
+            break;
         default:
             cerr << "Invalid testing code. See help menu (-h)\n";
             break;
@@ -765,8 +886,11 @@ int main(int argc, char* argv[]){
     // See the rng
     rng::seedRNG();
 
+    // Load the fastest GameOfLife settings for this machine, if it has been tuned
+    loadTunings(GAME_OF_LIFE_TUNING_FILE);
+
     // Command line options
-    const char* CMD_OPTIONS = "ht:r:";
+    const char* CMD_OPTIONS = "ht:r:T";
     // The current option
     char opt;
 
@@ -785,6 +909,12 @@ int main(int argc, char* argv[]){
             case 'r':
                 runOptions(atoi(optarg));
                 exit(EXIT_SUCCESS);
+            case 'T':
+                if(!autotuneAndSave(GAME_OF_LIFE_TUNING_FILE, cerr)){
+                    cerr << "Error: could not write " << GAME_OF_LIFE_TUNING_FILE << "\n";
+                    exit(EXIT_FAILURE);
+                }
+                exit(EXIT_SUCCESS);
             default:
                 break;
         }
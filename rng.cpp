@@ -1,12 +1,16 @@
 #include "rng.h"
 
 namespace rng{
-    std::uniform_real_distribution<double> dist;
-    std::mt19937 generator;
-    bool seeded;
+    thread_local std::uniform_real_distribution<double> dist;
+    thread_local std::mt19937 generator;
+    thread_local bool seeded;
 }
 
 void rng::seedRNG(){
+    // Only the first call seeds, so constructors do not throw away a stream that was already running or swapped in
+    if(seeded){
+        return;
+    }
     dist = std::uniform_real_distribution<double>(0.0, 1.0);
     generator.seed(std::random_device{}());
     seeded = true;
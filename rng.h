@@ -5,17 +5,19 @@
 #include <ctime>
 #include <limits>
 
+// Every thread has a generator of its own, so threads never race on it and a thread can swap in a saved stream to make its numbers repeatable
+// Note: a thread that was never seeded starts from the default seed of the Mersenne Twister
 namespace rng{
     // Double distribution between 0.0 and 1.0
-    extern std::uniform_real_distribution<double> dist;
+    extern thread_local std::uniform_real_distribution<double> dist;
 
     // Mersenne Twister for the technique to generate the numbers
-    extern std::mt19937 generator; 
+    extern thread_local std::mt19937 generator;
 
     // Flag for the rng being seeded
-    extern bool seeded;
+    extern thread_local bool seeded;
 
-    // Seed the rng
+    // Seed the rng of the calling thread from the random device, unless it was already seeded
     void seedRNG();
 
     // Generate a random number between min and max inclusive
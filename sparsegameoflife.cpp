@@ -0,0 +1,446 @@
+#include <iostream>
+
+#include "rng.h"
+#include "sparsegameoflife.h"
+#include "bitutils.h"
+#include "bitgameoflife.h"
+#include "gameoflife.h"
+
+//---------- HELPER FUNCTIONS ----------
+// Chunk that stands in for the missing chunks
+static const SparseChunk EMPTY_CHUNK = {};
+
+// Chunk coordinate of a cell coordinate, rounding towards negative infinity
+static inline int32_t toChunk(int64_t coordinate){
+    return (int32_t) (coordinate >> 6);
+}
+
+// Position of a cell coordinate inside its chunk
+static inline int toLocal(int64_t coordinate){
+    return (int) (coordinate & (SPARSE_CHUNK_SIZE - 1));
+}
+
+//-------------------------------------------------------------------------------------
+//---------- SparseGameOfLife ---------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+SparseGameOfLife::SparseGameOfLife() : regionChunks(0), regionsPerRow(0) {}
+
+SparseGameOfLife::SparseGameOfLife(const SparseGameOfLife & other) : chunks(other.chunks), regionChunks(other.regionChunks), regionsPerRow(other.regionsPerRow) {}
+
+SparseGameOfLife& SparseGameOfLife::operator=(const SparseGameOfLife & other){
+    if(this != &other){
+        chunks = other.chunks;
+        nextChunks.clear();
+        regionChunks = other.regionChunks;
+        regionsPerRow = other.regionsPerRow;
+    }
+    return *this;
+}
+
+SparseGameOfLife::~SparseGameOfLife(){}
+
+//---------- UTILITIES ----------
+void SparseGameOfLife::addOrganism(int64_t row, int64_t col, int orgRows, int orgCols, bool* organism){
+    int index = 0;
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            if(organism[index]){
+                setCell(row + i, col + j, true);
+            }
+            index++;
+        }
+    }
+}
+
+void SparseGameOfLife::addOrganism(int64_t row, int64_t col, int orgRows, int orgCols, char* organism){
+    int index = 0;
+    for(int i = 0; i < orgRows; i++){
+        for(int j = 0; j < orgCols; j++){
+            if(organism[index]){
+                setCell(row + i, col + j, true);
+            }
+            index++;
+        }
+    }
+}
+
+long long SparseGameOfLife::step(long long* regionChanges){
+    // Count of the changed tiles
+    long long count = 0;
+    // Resulting chunk
+    SparseChunk next;
+
+    nextChunks.clear();
+    for(auto& entry : chunks){
+        int32_t chunkRow = (int32_t) (entry.first >> 32);
+        int32_t chunkCol = (int32_t) (uint32_t) entry.first;
+        const SparseChunk& chunk = entry.second;
+
+        // Update the chunk itself, dropping it if it died out
+        int changes = stepChunk(chunkRow, chunkCol, next);
+        count += changes;
+        if(regionChanges && changes > 0){
+            int region = chunkRegion(chunkRow, chunkCol);
+            if(region >= 0){
+                regionChanges[region] += changes;
+            }
+        }
+        bool alive = false;
+        for(int i = 0; i < SPARSE_CHUNK_SIZE && !alive; i++){
+            alive = next.rows[i] != 0;
+        }
+        if(alive){
+            nextChunks.emplace(entry.first, next);
+        }
+
+        // Cells can only be born in a missing neighbor if this chunk has cells on the shared edge
+        uint64_t allRows = 0;
+        for(int i = 0; i < SPARSE_CHUNK_SIZE; i++){
+            allRows |= chunk.rows[i];
+        }
+        for(int dr = -1; dr <= 1; dr++){
+            uint64_t edgeRows = dr < 0 ? chunk.rows[0] : (dr > 0 ? chunk.rows[SPARSE_CHUNK_SIZE - 1] : allRows);
+            for(int dc = -1; dc <= 1; dc++){
+                uint64_t edgeCols = dc < 0 ? 1 : (dc > 0 ? ((uint64_t) 1) << (SPARSE_CHUNK_SIZE - 1) : ~((uint64_t) 0));
+                if((dr == 0 && dc == 0) || (edgeRows & edgeCols) == 0){
+                    continue;
+                }
+                uint64_t key = chunkKey(chunkRow + dr, chunkCol + dc);
+                if(chunks.count(key) || nextChunks.count(key)){
+                    continue;
+                }
+
+                // The chunk was empty, so every cell that is on afterwards is a change
+                int births = stepChunk(chunkRow + dr, chunkCol + dc, next);
+                if(births > 0){
+                    count += births;
+                    if(regionChanges){
+                        int region = chunkRegion(chunkRow + dr, chunkCol + dc);
+                        if(region >= 0){
+                            regionChanges[region] += births;
+                        }
+                    }
+                    nextChunks.emplace(key, next);
+                }
+            }
+        }
+    }
+
+    // Map shuffle
+    chunks.swap(nextChunks);
+
+    return count;
+}
+
+void SparseGameOfLife::getWindow(int64_t row, int64_t col, int rows, int cols, bool** data) const{
+    for(int i = 0; i < rows; i++){
+        for(int j = 0; j < cols; j++){
+            data[i][j] = getCell(row + i, col + j);
+        }
+    }
+}
+
+void SparseGameOfLife::clear(){
+    chunks.clear();
+}
+
+void SparseGameOfLife::clearRegion(int region){
+    for(auto it = chunks.begin(); it != chunks.end();){
+        if(chunkRegion((int32_t) (it->first >> 32), (int32_t) (uint32_t) it->first) == region){
+            it = chunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+//---------- ACCESSORS ----------
+bool SparseGameOfLife::getCell(int64_t row, int64_t col) const{
+    const SparseChunk* chunk = findChunk(toChunk(row), toChunk(col));
+    return chunk && ((chunk->rows[toLocal(row)] >> toLocal(col)) & 1);
+}
+
+long long SparseGameOfLife::getPopulation() const{
+    long long count = 0;
+    for(auto& entry : chunks){
+        for(int i = 0; i < SPARSE_CHUNK_SIZE; i++){
+            count += __builtin_popcountll(entry.second.rows[i]);
+        }
+    }
+    return count;
+}
+
+long long SparseGameOfLife::getCoordinateSums(double& rowSum, double& colSum) const{
+    long long count = 0;
+    rowSum = 0.0;
+    colSum = 0.0;
+    for(auto& entry : chunks){
+        int64_t rowStart = (int64_t) (int32_t) (entry.first >> 32) * SPARSE_CHUNK_SIZE;
+        int64_t colStart = (int64_t) (int32_t) (uint32_t) entry.first * SPARSE_CHUNK_SIZE;
+        for(int i = 0; i < SPARSE_CHUNK_SIZE; i++){
+            uint64_t word = entry.second.rows[i];
+            int rowCount = __builtin_popcountll(word);
+            count += rowCount;
+            rowSum += (double) rowCount * (rowStart + i);
+
+            // Visit the set bits only
+            while(word){
+                colSum += colStart + __builtin_ctzll(word);
+                word &= word - 1;
+            }
+        }
+    }
+    return count;
+}
+
+bool SparseGameOfLife::getBoundingBox(int64_t& minRow, int64_t& minCol, int64_t& maxRow, int64_t& maxCol) const{
+    bool found = false;
+    for(auto& entry : chunks){
+        int64_t rowStart = (int64_t) (int32_t) (entry.first >> 32) * SPARSE_CHUNK_SIZE;
+        int64_t colStart = (int64_t) (int32_t) (uint32_t) entry.first * SPARSE_CHUNK_SIZE;
+        for(int i = 0; i < SPARSE_CHUNK_SIZE; i++){
+            uint64_t word = entry.second.rows[i];
+            if(word == 0){
+                continue;
+            }
+            int64_t first = colStart + __builtin_ctzll(word);
+            int64_t last = colStart + SPARSE_CHUNK_SIZE - 1 - __builtin_clzll(word);
+            if(!found){
+                minRow = maxRow = rowStart + i;
+                minCol = first;
+                maxCol = last;
+                found = true;
+            } else {
+                minRow = min(minRow, rowStart + i);
+                maxRow = max(maxRow, rowStart + i);
+                minCol = min(minCol, first);
+                maxCol = max(maxCol, last);
+            }
+        }
+    }
+    return found;
+}
+
+int SparseGameOfLife::getChunkCount() const{
+    return (int) chunks.size();
+}
+
+uint64_t SparseGameOfLife::getHash() const{
+    // XOR of the hashes of every row of every chunk, so the order of the hash map does not matter
+    uint64_t hash = 0;
+    for(auto& entry : chunks){
+        for(int i = 0; i < SPARSE_CHUNK_SIZE; i++){
+            uint64_t word = entry.second.rows[i];
+            if(word){
+                hash ^= mixHash(word ^ mixHash(entry.first * SPARSE_CHUNK_SIZE + i));
+            }
+        }
+    }
+    return hash;
+}
+
+void SparseGameOfLife::getRegionStatistics(int numRegions, SparseRegionStatistics* stats) const{
+    for(int r = 0; r < numRegions; r++){
+        stats[r] = SparseRegionStatistics();
+    }
+
+    // Every chunk lies in a single region
+    for(auto& entry : chunks){
+        int32_t chunkRow = (int32_t) (entry.first >> 32);
+        int32_t chunkCol = (int32_t) (uint32_t) entry.first;
+        int region = chunkRegion(chunkRow, chunkCol);
+        if(region < 0 || region >= numRegions){
+            continue;
+        }
+        SparseRegionStatistics& regionStats = stats[region];
+        long long rowStart = (long long) (chunkRow % regionChunks) * SPARSE_CHUNK_SIZE;
+        long long colStart = (long long) (chunkCol % regionChunks) * SPARSE_CHUNK_SIZE;
+        for(int i = 0; i < SPARSE_CHUNK_SIZE; i++){
+            uint64_t word = entry.second.rows[i];
+            if(word == 0){
+                continue;
+            }
+            int rowCount = __builtin_popcountll(word);
+            regionStats.population += rowCount;
+            regionStats.rowSum += rowCount * (rowStart + i);
+            regionStats.colSum += rowCount * colStart;
+            regionStats.hash ^= mixHash(word ^ mixHash(entry.first * SPARSE_CHUNK_SIZE + i));
+
+            // Sum of the set bit positions, one bit of the position at a time
+            for(int b = 0; b < 6; b++){
+                regionStats.colSum += (long long) __builtin_popcountll(word & POSITION_BITS[b]) << b;
+            }
+        }
+    }
+}
+
+int64_t SparseGameOfLife::getRegionRow(int region) const{
+    return (int64_t) (region / regionsPerRow) * regionChunks * SPARSE_CHUNK_SIZE;
+}
+
+int64_t SparseGameOfLife::getRegionCol(int region) const{
+    return (int64_t) (region % regionsPerRow) * regionChunks * SPARSE_CHUNK_SIZE;
+}
+
+//---------- MUTATORS ----------
+void SparseGameOfLife::setRegions(int regionChunks, int regionsPerRow){
+    this->regionChunks = regionChunks;
+    this->regionsPerRow = regionsPerRow;
+}
+
+void SparseGameOfLife::setCell(int64_t row, int64_t col, bool val){
+    uint64_t key = chunkKey(toChunk(row), toChunk(col));
+    uint64_t bit = ((uint64_t) 1) << toLocal(col);
+    if(val){
+        // Creates a zeroed chunk if needed
+        chunks[key].rows[toLocal(row)] |= bit;
+        return;
+    }
+
+    auto found = chunks.find(key);
+    if(found == chunks.end()){
+        return;
+    }
+    found->second.rows[toLocal(row)] &= ~bit;
+
+    // Drop the chunk if it emptied out
+    for(int i = 0; i < SPARSE_CHUNK_SIZE; i++){
+        if(found->second.rows[i]){
+            return;
+        }
+    }
+    chunks.erase(found);
+}
+
+//---------- DEBUGGING UTILITIES ----------
+ostream& operator<<(ostream& os, const SparseGameOfLife& obj){
+    int64_t minRow, minCol, maxRow, maxCol;
+    if(!obj.getBoundingBox(minRow, minCol, maxRow, maxCol)){
+        return os;
+    }
+    for(int64_t i = minRow; i <= maxRow; i++){
+        for(int64_t j = minCol; j <= maxCol; j++){
+            if(obj.getCell(i, j)){
+                os << "1";
+            } else {
+                os << "0";
+            }
+        }
+        os << "\n";
+    }
+    return os;
+}
+
+//---------- PRIVATE UTILITIES ----------
+uint64_t SparseGameOfLife::chunkKey(int32_t chunkRow, int32_t chunkCol){
+    return (((uint64_t) (uint32_t) chunkRow) << 32) | (uint32_t) chunkCol;
+}
+
+int SparseGameOfLife::chunkRegion(int32_t chunkRow, int32_t chunkCol) const{
+    if(regionChunks <= 0 || chunkRow < 0 || chunkCol < 0 || chunkCol / regionChunks >= regionsPerRow){
+        return -1;
+    }
+    return (chunkRow / regionChunks) * regionsPerRow + chunkCol / regionChunks;
+}
+
+const SparseChunk* SparseGameOfLife::findChunk(int32_t chunkRow, int32_t chunkCol) const{
+    auto found = chunks.find(chunkKey(chunkRow, chunkCol));
+    return found == chunks.end() ? nullptr : &found->second;
+}
+
+int SparseGameOfLife::stepChunk(int32_t chunkRow, int32_t chunkCol, SparseChunk& next) const{
+    // Count of the changed tiles
+    int count = 0;
+
+    // The chunk and its 8 neighbors, missing chunks read as empty
+    const SparseChunk* around[3][3];
+    for(int dr = -1; dr <= 1; dr++){
+        for(int dc = -1; dc <= 1; dc++){
+            const SparseChunk* chunk = findChunk(chunkRow + dr, chunkCol + dc);
+            around[dr + 1][dc + 1] = chunk ? chunk : &EMPTY_CHUNK;
+        }
+    }
+
+    // Apply rules of Conway's Game of Life a whole row at a time
+    uint64_t west[3];
+    uint64_t center[3];
+    uint64_t east[3];
+    for(int i = 0; i < SPARSE_CHUNK_SIZE; i++){
+        // Rows above, at and below, reaching into the chunks above and below at the edges
+        for(int k = 0; k < 3; k++){
+            int row = i + k - 1;
+            int band = row < 0 ? 0 : (row >= SPARSE_CHUNK_SIZE ? 2 : 1);
+            int local = (row + SPARSE_CHUNK_SIZE) % SPARSE_CHUNK_SIZE;
+            uint64_t left = around[band][0]->rows[local];
+            uint64_t mid = around[band][1]->rows[local];
+            uint64_t right = around[band][2]->rows[local];
+
+            // Lower bits are further left, so the left neighbor comes from one bit lower
+            west[k] = (mid << 1) | (left >> (SPARSE_CHUNK_SIZE - 1));
+            center[k] = mid;
+            east[k] = (mid >> 1) | (right << (SPARSE_CHUNK_SIZE - 1));
+        }
+        next.rows[i] = lifeWord(west[0], center[0], east[0], west[1], center[1], east[1], west[2], center[2], east[2]);
+
+        // Count the number of changes
+        count += __builtin_popcountll(next.rows[i] ^ center[1]);
+    }
+    return count;
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_SparseGameOfLife(){
+    // A random soup straddling the origin, compared against the middle of a torus large enough that nothing wraps around in time
+    int size = 400;
+    int soup = 40;
+    int numSteps = 150;
+    GameOfLife game = GameOfLife(size, size);
+    SparseGameOfLife sparseGame = SparseGameOfLife();
+    bool** board = game.getBoard();
+    for(int i = -soup / 2; i < soup / 2; i++){
+        for(int j = -soup / 2; j < soup / 2; j++){
+            bool val = rng::genRandDouble(0.0, 1.0) < 0.4;
+            board[size / 2 + i][size / 2 + j] = val;
+            sparseGame.setCell(i, j, val);
+        }
+    }
+    game.invalidateTiles();
+
+    // Step both forward and compare the changes and the boards
+    bool passed = true;
+    for(int k = 0; k < numSteps && passed; k++){
+        passed = game.step() == sparseGame.step();
+
+        board = game.getBoard();
+        for(int i = 0; i < size && passed; i++){
+            for(int j = 0; j < size && passed; j++){
+                passed = board[i][j] == sparseGame.getCell(i - size / 2, j - size / 2);
+            }
+        }
+    }
+    cout << "SparseGameOfLife soup: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // A glider flies off forever without wrapping and only ever needs a few chunks
+    bool glider[] = {
+        0, 1, 0,
+        0, 0, 1,
+        1, 1, 1
+    };
+    sparseGame.clear();
+    sparseGame.addOrganism(0, 0, 3, 3, glider);
+    int maxChunks = 0;
+    int generations = 10000;
+    for(int k = 0; k < generations; k++){
+        sparseGame.step();
+        maxChunks = max(maxChunks, sparseGame.getChunkCount());
+    }
+    int64_t shift = generations / 4;
+    passed = sparseGame.getPopulation() == 5 && maxChunks <= 4;
+    for(int i = 0; i < 3 && passed; i++){
+        for(int j = 0; j < 3 && passed; j++){
+            passed = sparseGame.getCell(i + shift, j + shift) == glider[i * 3 + j];
+        }
+    }
+    cout << "SparseGameOfLife glider: " << (passed ? "PASSED" : "FAILED") << "\n";
+}
@@ -0,0 +1,111 @@
+#ifndef SPARSE_GAME_OF_LIFE_H
+#define SPARSE_GAME_OF_LIFE_H
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+
+using namespace std;
+
+/*
+Sparse Game of Life
+
+A Game of Life on an unbounded plane. Only the occupied parts of the plane are stored, as 64 x 64 chunks of bit packed cells in a hash map keyed by the chunk coordinates. A chunk is created as soon as a pattern grows into it and dropped as soon as it empties out, so memory use and the cost of a step scale with the live area of the pattern rather than with a bounding box or torus.
+
+Cells use signed coordinates so patterns are free to move in any direction. Nothing ever wraps around, a glider keeps flying forever.
+
+Several patterns can share one plane as long as they are placed far enough apart that they never meet. setRegions() splits the plane into a grid of square regions made of whole chunks, after which step() and getRegionStatistics() report the changes, population, coordinates and hash of each region separately.
+*/
+
+//---------- CONSTANTS ----------
+// Width and height of a chunk in cells - one word per row
+const int SPARSE_CHUNK_SIZE = 64;
+
+// A 64 x 64 block of cells, bit j of rows[i] holds column j of row i
+struct SparseChunk {
+    uint64_t rows[SPARSE_CHUNK_SIZE];
+};
+
+// What is on in one region of the plane
+struct SparseRegionStatistics {
+    // Number of cells that are on
+    long long population = 0;
+    // Sums of the row and column coordinates of the cells that are on, measured from the top left corner of the region
+    long long rowSum = 0;
+    long long colSum = 0;
+    // Hash of the cells that are on, the empty region hashes to 0
+    uint64_t hash = 0;
+};
+
+class SparseGameOfLife{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        SparseGameOfLife();
+        SparseGameOfLife(const SparseGameOfLife & other);
+        SparseGameOfLife& operator=(const SparseGameOfLife & other);
+        ~SparseGameOfLife();
+
+        //---------- UTILITIES ----------
+        // Adds the organism with its top left corner at (row, col) without clearing the board. Allows for both bool arrays and char arrays which match the genetic algorithm code
+        void addOrganism(int64_t row, int64_t col, int orgRows, int orgCols, bool* organism);
+        void addOrganism(int64_t row, int64_t col, int orgRows, int orgCols, char* organism);
+        // Performs a single step of the game of life counting the net number of tiles changed
+        // If regionChanges is given the changes of every region are added to it as well
+        long long step(long long* regionChanges = nullptr);
+        // Creates a copy of the rows x cols window with its top left corner at (row, col) overwriting the data
+        void getWindow(int64_t row, int64_t col, int rows, int cols, bool** data) const;
+        // Removes every cell
+        void clear();
+        // Removes every cell of the region
+        void clearRegion(int region);
+
+        //---------- ACCESSORS ----------
+        bool getCell(int64_t row, int64_t col) const;
+        long long getPopulation() const;
+        // Sums the row and column coordinates of every cell that is on, returns the population
+        long long getCoordinateSums(double& rowSum, double& colSum) const;
+        // Smallest rectangle holding every cell that is on, returns false if the board is empty
+        bool getBoundingBox(int64_t& minRow, int64_t& minCol, int64_t& maxRow, int64_t& maxCol) const;
+        // Number of chunks currently allocated
+        int getChunkCount() const;
+        // Returns a 64 bit hash of the cells that are on, the empty board hashes to 0
+        uint64_t getHash() const;
+        // Fills in the statistics of the first numRegions regions
+        void getRegionStatistics(int numRegions, SparseRegionStatistics* stats) const;
+        // Top left corner of the region
+        int64_t getRegionRow(int region) const;
+        int64_t getRegionCol(int region) const;
+
+        //---------- MUTATORS ----------
+        void setCell(int64_t row, int64_t col, bool val);
+        // Splits the plane from (0, 0) into square regions regionChunks chunks wide, regionsPerRow of them to a row, 0 turns the regions off
+        // Region r is in row r / regionsPerRow and column r % regionsPerRow of the grid, cells above or left of (0, 0) are in no region
+        void setRegions(int regionChunks, int regionsPerRow);
+
+        //---------- DEBUGGING UTILITIES ----------
+        // Prints out the bounding box as 0s and 1s to an ostream
+        friend ostream& operator<<(ostream& os, const SparseGameOfLife& obj);
+    private:
+        // The occupied chunks, keyed by the chunk coordinates
+        unordered_map<uint64_t, SparseChunk> chunks;
+        // The chunks of the next step, swapped with chunks at the end of every step so the map memory is reused
+        unordered_map<uint64_t, SparseChunk> nextChunks;
+        // Grid of regions, 0 if there is none
+        int regionChunks;
+        int regionsPerRow;
+
+        //---------- PRIVATE UTILITIES ----------
+        // Packs the chunk coordinates into a hash map key
+        static uint64_t chunkKey(int32_t chunkRow, int32_t chunkCol);
+        // Region of the chunk at the chunk coordinates, -1 if it is in none
+        int chunkRegion(int32_t chunkRow, int32_t chunkCol) const;
+        // Returns the chunk at the chunk coordinates or nullptr if it is empty
+        const SparseChunk* findChunk(int32_t chunkRow, int32_t chunkCol) const;
+        // Computes the next state of the chunk at the chunk coordinates into next, returns the number of cells changed
+        int stepChunk(int32_t chunkRow, int32_t chunkCol, SparseChunk& next) const;
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_SparseGameOfLife();
+
+#endif
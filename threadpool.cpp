@@ -0,0 +1,121 @@
+#include <iostream>
+
+#include "threadpool.h"
+
+//-------------------------------------------------------------------------------------
+//---------- ThreadPool ---------------------------------------------------------------
+//-------------------------------------------------------------------------------------
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+ThreadPool::ThreadPool(int numThreads) : numThreads(numThreads), job(nullptr), numTasks(0), nextTask(0), running(0), jobId(0), stopping(false) {
+    if(this->numThreads <= 0){
+        this->numThreads = max((int) thread::hardware_concurrency(), 1);
+    }
+
+    // The calling thread is worker 0
+    for(int i = 1; i < this->numThreads; i++){
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(thread& worker : workers){
+        worker.join();
+    }
+}
+
+//---------- UTILITIES ----------
+void ThreadPool::parallelFor(int numTasks, const function<void(int, int)>& task){
+    // Not worth waking anyone up for
+    if(workers.empty() || numTasks <= 1){
+        for(int i = 0; i < numTasks; i++){
+            task(i, 0);
+        }
+        return;
+    }
+
+    // Post the job
+    {
+        lock_guard<mutex> guard(lock);
+        job = &task;
+        this->numTasks = numTasks;
+        nextTask = 0;
+        running = (int) workers.size();
+        jobId++;
+    }
+    wake.notify_all();
+
+    // Help out, then wait for the rest of the workers
+    runTasks(0);
+    unique_lock<mutex> guard(lock);
+    done.wait(guard, [this]{ return running == 0; });
+    job = nullptr;
+}
+
+//---------- ACCESSORS ----------
+int ThreadPool::getNumThreads() const{
+    return numThreads;
+}
+
+//---------- PRIVATE UTILITIES ----------
+void ThreadPool::workerLoop(int worker){
+    uint64_t lastJob = 0;
+    while(true){
+        // Wait for a new job
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [this, lastJob]{ return stopping || jobId != lastJob; });
+            if(stopping){
+                return;
+            }
+            lastJob = jobId;
+        }
+
+        runTasks(worker);
+
+        // Report back
+        {
+            lock_guard<mutex> guard(lock);
+            running--;
+            if(running == 0){
+                done.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::runTasks(int worker){
+    for(int task = nextTask++; task < numTasks; task = nextTask++){
+        (*job)(task, worker);
+    }
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_ThreadPool(){
+    ThreadPool pool = ThreadPool(4);
+    int numTasks = 1000;
+    vector<int> runs(numTasks, 0);
+    vector<long long> sums(pool.getNumThreads(), 0);
+
+    // Every task should run exactly once, over many back to back jobs
+    bool passed = true;
+    for(int round = 0; round < 100; round++){
+        pool.parallelFor(numTasks, [&](int task, int worker){
+            runs[task]++;
+            sums[worker] += task;
+        });
+    }
+    long long total = 0;
+    for(long long sum : sums){
+        total += sum;
+    }
+    for(int i = 0; i < numTasks; i++){
+        passed = passed && runs[i] == 100;
+    }
+    passed = passed && total == 100LL * numTasks * (numTasks - 1) / 2;
+    cout << "ThreadPool " << pool.getNumThreads() << " threads: " << (passed ? "PASSED" : "FAILED") << "\n";
+}
@@ -0,0 +1,71 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/*
+Thread Pool
+
+A fixed set of worker threads that is created once and reused, so a simulation can run in parallel every step without paying to start threads each time. Work is handed out as a parallel for loop: every task index in [0, numTasks) is run exactly once by some thread and parallelFor() returns once all of them are done. The calling thread takes part as worker 0, so a pool of n threads only starts n - 1 of them.
+
+Tasks are claimed one at a time from a shared counter, so uneven tasks balance out across the workers. Each task is told which worker is running it so it can use per-worker scratch memory without locking.
+*/
+
+class ThreadPool{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        // Creates a pool with the number of threads, including the calling thread - 0 or less uses every hardware thread
+        ThreadPool(int numThreads);
+        // Threads can not be copied
+        ThreadPool(const ThreadPool & other) = delete;
+        ThreadPool& operator=(const ThreadPool & other) = delete;
+        ~ThreadPool();
+
+        //---------- UTILITIES ----------
+        // Runs task(taskIndex, worker) for every task index in [0, numTasks) and waits for all of them to finish
+        void parallelFor(int numTasks, const function<void(int, int)>& task);
+
+        //---------- ACCESSORS ----------
+        int getNumThreads() const;
+    private:
+        // Number of threads including the calling thread
+        int numThreads;
+        // The started threads, workers 1 to numThreads - 1
+        vector<thread> workers;
+        // Protects the job and the counters below
+        mutex lock;
+        // Signals the workers that a new job is ready or that the pool is shutting down
+        condition_variable wake;
+        // Signals the calling thread that the workers are done with the job
+        condition_variable done;
+        // The current job
+        const function<void(int, int)>* job;
+        int numTasks;
+        // Next task index to hand out
+        atomic<int> nextTask;
+        // Number of started threads still working on the job
+        int running;
+        // Incremented for every job so the workers can tell a new job from a spurious wake up
+        uint64_t jobId;
+        // Set when the pool is being destroyed
+        bool stopping;
+
+        //---------- PRIVATE UTILITIES ----------
+        // Main loop of the started threads
+        void workerLoop(int worker);
+        // Claims and runs tasks of the current job until there are none left
+        void runTasks(int worker);
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_ThreadPool();
+
+#endif
@@ -0,0 +1,174 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#include "transpositiontable.h"
+#include "bitutils.h"
+#include "gameoflife.h"
+
+//---------- CONSTRUCTORS & DESTRUCTOR ----------
+TranspositionTable::TranspositionTable() : TranspositionTable(TRANSPOSITION_TABLE_DEFAULT_SLOTS) {}
+
+TranspositionTable::TranspositionTable(size_t slots) : lookups(0), hits(0), stores(0) {
+    // Round up to a power of two so the slot is a mask of the hash
+    size_t size = 1;
+    while(size < slots){
+        size <<= 1;
+    }
+    entries = vector<TranspositionEntry>(size, TranspositionEntry{0, -1, 0.0});
+    mask = size - 1;
+}
+
+TranspositionTable::~TranspositionTable(){}
+
+//---------- UTILITIES ----------
+bool TranspositionTable::lookup(uint64_t hash, int remaining, double& value){
+    lookups.fetch_add(1, memory_order_relaxed);
+    size_t slot = slotOf(hash, remaining);
+    lock_guard<mutex> lock(shards[slot % TRANSPOSITION_TABLE_SHARDS]);
+    const TranspositionEntry& entry = entries[slot];
+    if(entry.hash != hash || entry.remaining != remaining){
+        return false;
+    }
+    value = entry.value;
+    hits.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+void TranspositionTable::store(uint64_t hash, int remaining, double value){
+    stores.fetch_add(1, memory_order_relaxed);
+    size_t slot = slotOf(hash, remaining);
+    lock_guard<mutex> lock(shards[slot % TRANSPOSITION_TABLE_SHARDS]);
+    entries[slot] = TranspositionEntry{hash, remaining, value};
+}
+
+void TranspositionTable::clear(){
+    for(int s = 0; s < TRANSPOSITION_TABLE_SHARDS; s++){
+        lock_guard<mutex> lock(shards[s]);
+        for(size_t slot = s; slot < entries.size(); slot += TRANSPOSITION_TABLE_SHARDS){
+            entries[slot] = TranspositionEntry{0, -1, 0.0};
+        }
+    }
+    lookups = 0;
+    hits = 0;
+    stores = 0;
+}
+
+//---------- ACCESSORS ----------
+size_t TranspositionTable::getSlots() const{
+    return entries.size();
+}
+
+size_t TranspositionTable::getMemory() const{
+    return entries.size() * sizeof(TranspositionEntry);
+}
+
+long long TranspositionTable::getLookups() const{
+    return lookups.load();
+}
+
+long long TranspositionTable::getHits() const{
+    return hits.load();
+}
+
+long long TranspositionTable::getStores() const{
+    return stores.load();
+}
+
+double TranspositionTable::getHitRate() const{
+    long long count = lookups.load();
+    return count == 0 ? 0.0 : ((double) hits.load()) / ((double) count);
+}
+
+//---------- PRIVATE UTILITIES ----------
+size_t TranspositionTable::slotOf(uint64_t hash, int remaining) const{
+    // The same board with a different number of steps left goes to an unrelated slot
+    return mixHash(hash ^ mixHash((uint64_t) remaining + 1)) & mask;
+}
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_TranspositionTable(){
+    // Values should come back for the same key only, and a new value replaces the old one
+    TranspositionTable table = TranspositionTable(1000);
+    double value = 0.0;
+    bool passed = table.getSlots() == 1024 && !table.lookup(42, 10, value);
+    table.store(42, 10, 1.5);
+    passed = passed && table.lookup(42, 10, value) && value == 1.5;
+    passed = passed && !table.lookup(42, 9, value) && !table.lookup(43, 10, value);
+    table.store(42, 10, 2.5);
+    passed = passed && table.lookup(42, 10, value) && value == 2.5;
+    passed = passed && table.getLookups() == 5 && table.getHits() == 2 && table.getStores() == 2;
+    table.clear();
+    passed = passed && !table.lookup(42, 10, value) && table.getLookups() == 1 && table.getHits() == 0;
+    cout << "Transposition table store: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Threads sharing the table should only ever read back the value stored for the key
+    table.clear();
+    const int numThreads = 4;
+    bool threadPassed[numThreads];
+    vector<thread> threads;
+    for(int t = 0; t < numThreads; t++){
+        threads.push_back(thread([&table, &threadPassed, t](){
+            threadPassed[t] = true;
+            for(int i = 0; i < 100000; i++){
+                uint64_t hash = (uint64_t) ((i * 7 + t) % 5000);
+                int remaining = (int) (hash % 17);
+                double found;
+                table.store(hash, remaining, (double) hash * 0.5);
+                if(table.lookup((hash * 31) % 5000, (int) (((hash * 31) % 5000) % 17), found)){
+                    threadPassed[t] = threadPassed[t] && found == (double) ((hash * 31) % 5000) * 0.5;
+                }
+            }
+        }));
+    }
+    for(int t = 0; t < numThreads; t++){
+        threads[t].join();
+    }
+    passed = table.getStores() == numThreads * 100000 && table.getLookups() == numThreads * 100000;
+    for(int t = 0; t < numThreads; t++){
+        passed = passed && threadPassed[t];
+    }
+    cout << "Transposition table threads: " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // The GameOfLifeGA should give the same fitness with a table, which fills up over a few generations of training
+    char actions[] = {0, 1};
+    GoLFitnessFunction functions[] = {GoLFitnessFunction::FinalStepTiles, GoLFitnessFunction::AverageChangeTiles, GoLFitnessFunction::CenterOfMassMotion};
+    const char* names[] = {"FinalStepTiles", "AverageChangeTiles", "CenterOfMassMotion"};
+    GoLBoundary boundaries[] = {GoLBoundary::Toroidal, GoLBoundary::Unbounded};
+    const char* boundaryNames[] = {"torus", "unbounded"};
+    TranspositionTable shared = TranspositionTable();
+    for(int b = 0; b < 2; b++){
+        for(int f = 0; f < 3; f++){
+            shared.clear();
+            GameOfLifeGA plain = GameOfLifeGA(100, 8 * 8, 2, actions, 1, 0.005, 1, 27, 27, functions[f], 300, 8, 8, boundaries[b]);
+            plain.setBatching(false);
+            GameOfLifeGA cached = GameOfLifeGA(plain);
+            cached.setTranspositionTable(&shared);
+
+            passed = true;
+            double plainTime = 0.0;
+            double cachedTime = 0.0;
+            for(int gen = 0; gen < 5 && passed; gen++){
+                auto start = chrono::steady_clock::now();
+                plain.evalFitness();
+                auto middle = chrono::steady_clock::now();
+                cached.evalFitness();
+                auto end = chrono::steady_clock::now();
+                plainTime += chrono::duration<double>(middle - start).count();
+                cachedTime += chrono::duration<double>(end - middle).count();
+
+                for(int member = 0; member < 100 && passed; member++){
+                    passed = fabs(plain.getFitness(member) - cached.getFitness(member)) <= 1e-9 * max(1.0, fabs(plain.getFitness(member)));
+                }
+
+                // Move both on to the same next population
+                plain.breed();
+                plain.mutate();
+                cached = GameOfLifeGA(plain);
+                cached.setTranspositionTable(&shared);
+            }
+            cout << "Transposition table " << names[f] << " " << boundaryNames[b] << ": " << (passed ? "PASSED" : "FAILED") << ", hit rate " << shared.getHitRate() << ", " << shared.getMemory() / 1024 << " KiB, without " << plainTime << "s, with " << cachedTime << "s\n";
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+/*
+Transposition Table
+
+A fixed size cache of values worked out from the middle of a deterministic simulation, keyed by the hash of the state and the number of generations left to simulate. Different organisms often run into the same board part way through, an empty board or a lone block or blinker, and everything they add to their fitness from there on is the same. A simulation that finds its board in the table can stop and add the stored value.
+
+The table is a power of two number of slots. A key maps to a single slot and a new value always replaces the old one, so memory use is fixed however many values are stored. The slots are split into shards with a lock each, so many threads can share one table and rarely wait for each other.
+
+Hashes are 64 bits and collisions are assumed never to happen, the caller mixes anything else the value depends on into the hash.
+*/
+
+//---------- CONSTANTS ----------
+// Number of slots of a table made with the default constructor
+const size_t TRANSPOSITION_TABLE_DEFAULT_SLOTS = 1 << 18;
+// Number of locks the slots are split between
+const int TRANSPOSITION_TABLE_SHARDS = 64;
+
+// A stored value
+struct TranspositionEntry {
+    // Hash of the state
+    uint64_t hash;
+    // Generations left to simulate from the state, -1 for an empty slot
+    int remaining;
+    // The value
+    double value;
+};
+
+class TranspositionTable{
+    public:
+        //---------- CONSTRUCTORS & DESTRUCTOR ----------
+        TranspositionTable();
+        // Creates a table with at least the number of slots, rounded up to a power of two
+        TranspositionTable(size_t slots);
+        // The locks can not be copied
+        TranspositionTable(const TranspositionTable & other) = delete;
+        TranspositionTable& operator=(const TranspositionTable & other) = delete;
+        ~TranspositionTable();
+
+        //---------- UTILITIES ----------
+        // Looks up the value stored for the state, returns false if there is none
+        bool lookup(uint64_t hash, int remaining, double& value);
+        // Stores the value for the state, replacing whatever was in its slot
+        void store(uint64_t hash, int remaining, double value);
+        // Empties every slot and resets the counters
+        void clear();
+
+        //---------- ACCESSORS ----------
+        size_t getSlots() const;
+        // Memory used by the slots in bytes
+        size_t getMemory() const;
+        long long getLookups() const;
+        long long getHits() const;
+        long long getStores() const;
+        // Fraction of the lookups that found a value, 0 if there were none
+        double getHitRate() const;
+    private:
+        // The slots
+        vector<TranspositionEntry> entries;
+        // One less than the number of slots
+        size_t mask;
+        // Locks of the shards, slot i belongs to shard i % TRANSPOSITION_TABLE_SHARDS
+        mutex shards[TRANSPOSITION_TABLE_SHARDS];
+        // Counters
+        atomic<long long> lookups;
+        atomic<long long> hits;
+        atomic<long long> stores;
+
+        //---------- PRIVATE UTILITIES ----------
+        // Slot of the state
+        size_t slotOf(uint64_t hash, int remaining) const;
+};
+
+//---------- EXTERNAL FUNCTIONS ----------
+void test_TranspositionTable();
+
+#endif